@@ -12,6 +12,7 @@ CHECK_FUNCTION_EXISTS("setenv" HAVE_SETENV)
 CHECK_FUNCTION_EXISTS("ldexpf" HAVE_LDEXPF)
 CHECK_FUNCTION_EXISTS("realpath" HAVE_REALPATH)
 CHECK_FUNCTION_EXISTS("mmap" HAVE_MMAP)
+CHECK_FUNCTION_EXISTS("pread" HAVE_PREAD)
 CHECK_FUNCTION_EXISTS("_aligned_malloc" HAVE_ALIGNED_MALLOC)
 CHECK_FUNCTION_EXISTS("memalign" HAVE_MEMALIGN)
 CHECK_FUNCTION_EXISTS("posix_memalign" HAVE_POSIX_MEMALIGN)
@@ -0,0 +1,103 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorGrid.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+ActorGrid::ActorGrid(const Size& mapSize)
+	: gridSize((mapSize.w + CELL_SIZE - 1) / CELL_SIZE, (mapSize.h + CELL_SIZE - 1) / CELL_SIZE)
+{
+	gridSize.w = std::max(gridSize.w, 1);
+	gridSize.h = std::max(gridSize.h, 1);
+	cells.resize(gridSize.Area());
+}
+
+// actors wandering off the map are kept in the border cells
+size_t ActorGrid::CellIndex(const Point& p) const noexcept
+{
+	int x = Clamp(p.x / CELL_SIZE, 0, gridSize.w - 1);
+	int y = Clamp(p.y / CELL_SIZE, 0, gridSize.h - 1);
+	return y * gridSize.w + x;
+}
+
+void ActorGrid::Insert(const Actor* actor, size_t idx)
+{
+	size_t cell = CellIndex(actor->Pos);
+	cells[cell].push_back(idx);
+	slots[actor] = { idx, cell };
+	maxReach = std::max(maxReach, (actor->circleSize - 1) * 16);
+}
+
+void ActorGrid::Rebuild(const std::vector<Actor*>& actors)
+{
+	for (auto& cell : cells) {
+		cell.clear();
+	}
+	slots.clear();
+	for (size_t idx = 0; idx < actors.size(); ++idx) {
+		Insert(actors[idx], idx);
+	}
+}
+
+void ActorGrid::Add(const Actor* actor, size_t idx)
+{
+	if (cells.empty()) return;
+	Insert(actor, idx);
+}
+
+void ActorGrid::Update(const Actor* actor)
+{
+	auto it = slots.find(actor);
+	if (it == slots.end()) return;
+
+	maxReach = std::max(maxReach, (actor->circleSize - 1) * 16);
+	Slot& slot = it->second;
+	size_t cell = CellIndex(actor->Pos);
+	if (cell == slot.cell) return;
+
+	auto& oldCell = cells[slot.cell];
+	oldCell.erase(std::find(oldCell.begin(), oldCell.end(), slot.index));
+	cells[cell].push_back(slot.index);
+	slot.cell = cell;
+}
+
+void ActorGrid::Query(Region rgn, std::vector<size_t>& found) const
+{
+	found.clear();
+	if (cells.empty()) return;
+
+	rgn.ExpandAllSides(maxReach);
+	size_t first = CellIndex(rgn.origin);
+	size_t last = CellIndex(rgn.Maximum());
+	for (size_t y = first / gridSize.w; y <= last / gridSize.w; ++y) {
+		for (size_t x = first % gridSize.w; x <= last % gridSize.w; ++x) {
+			const auto& cell = cells[y * gridSize.w + x];
+			found.insert(found.end(), cell.cbegin(), cell.cend());
+		}
+	}
+	std::sort(found.begin(), found.end());
+}
+
+}
@@ -0,0 +1,73 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORGRID_H
+#define ACTORGRID_H
+
+#include "Region.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+// Uniform grid over the actor positions of a map, so proximity queries only
+// need to look at the actors in the nearby cells.
+// It stores indices into the map's actor list, so query results can be
+// visited in the same order as a plain scan of that list would.
+class ActorGrid {
+public:
+	static constexpr int CELL_SIZE = 128; // in navmap pixels
+
+	ActorGrid() noexcept = default;
+	explicit ActorGrid(const Size& mapSize);
+
+	// call after the actor list was reordered or shrunk
+	void Rebuild(const std::vector<Actor*>& actors);
+	// call after an actor was appended to the actor list
+	void Add(const Actor* actor, size_t idx);
+	// call after an actor changed its position, Scriptable::SetPos does it for you
+	void Update(const Actor* actor);
+
+	// fills found with the indices of actors that could be inside rgn, once it's
+	// grown by the biggest actor circle, so callers can do their exact checks; sorted
+	void Query(Region rgn, std::vector<size_t>& found) const;
+
+private:
+	struct Slot {
+		size_t index;
+		size_t cell;
+	};
+
+	Size gridSize;
+	std::vector<std::vector<size_t>> cells;
+	std::unordered_map<const Actor*, Slot> slots;
+	// how far from its position an actor's circle can reach
+	int maxReach = 16;
+
+	size_t CellIndex(const Point& p) const noexcept;
+	void Insert(const Actor* actor, size_t idx);
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorStatIndex.h"
+
+#include "ie_stats.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+
+namespace GemRB {
+
+// class is missing, since ID_Class also looks at levels and dual-classing
+const std::array<unsigned int, ActorStatIndex::STAT_COUNT> ActorStatIndex::indexedStats { {
+	IE_EA, IE_GENERAL, IE_RACE, IE_SPECIFIC, IE_SEX, IE_ALIGNMENT
+} };
+
+int ActorStatIndex::StatSlot(unsigned int stat) noexcept
+{
+	auto it = std::find(indexedStats.cbegin(), indexedStats.cend(), stat);
+	if (it == indexedStats.cend()) return -1;
+	return static_cast<int>(it - indexedStats.cbegin());
+}
+
+void ActorStatIndex::Rebuild(const std::vector<Actor*>& actors)
+{
+	for (auto& statBuckets : buckets) {
+		statBuckets.clear();
+	}
+	entries.clear();
+	for (size_t idx = 0; idx < actors.size(); ++idx) {
+		Add(actors[idx], idx);
+	}
+}
+
+void ActorStatIndex::Add(const Actor* actor, size_t idx)
+{
+	Entry& entry = entries[actor];
+	entry.index = idx;
+	for (size_t slot = 0; slot < STAT_COUNT; ++slot) {
+		entry.values[slot] = actor->GetStat(indexedStats[slot]);
+		buckets[slot][entry.values[slot]].push_back(idx);
+	}
+}
+
+void ActorStatIndex::Update(const Actor* actor)
+{
+	auto it = entries.find(actor);
+	if (it == entries.end()) return;
+
+	Entry& entry = it->second;
+	for (size_t slot = 0; slot < STAT_COUNT; ++slot) {
+		ieDword value = actor->GetStat(indexedStats[slot]);
+		if (value == entry.values[slot]) continue;
+
+		auto old = buckets[slot].find(entry.values[slot]);
+		auto& indices = old->second;
+		indices.erase(std::find(indices.begin(), indices.end(), entry.index));
+		if (indices.empty()) {
+			buckets[slot].erase(old);
+		}
+		buckets[slot][value].push_back(entry.index);
+		entry.values[slot] = value;
+	}
+}
+
+void ActorStatIndex::Sync(const std::vector<Actor*>& actors)
+{
+	for (const Actor* actor : actors) {
+		Update(actor);
+	}
+}
+
+}
@@ -0,0 +1,71 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORSTATINDEX_H
+#define ACTORSTATINDEX_H
+
+#include "ie_types.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+// Buckets the actors of a map by the stats IDS object matching looks at
+// ([ENEMY], [0.0.DOG], ...), so scripts can start from the actors with the
+// right values instead of every actor in the area.
+// Like ActorGrid, it stores indices into the map's actor list.
+class ActorStatIndex {
+public:
+	static constexpr size_t STAT_COUNT = 6;
+	static const std::array<unsigned int, STAT_COUNT> indexedStats;
+	// position in indexedStats or -1
+	static int StatSlot(unsigned int stat) noexcept;
+
+	// actor indices by stat value
+	using Buckets = std::unordered_map<ieDword, std::vector<size_t>>;
+
+	// call after the actor list was reordered or shrunk
+	void Rebuild(const std::vector<Actor*>& actors);
+	// call after an actor was appended to the actor list
+	void Add(const Actor* actor, size_t idx);
+	// call after any of the indexed stats of an actor changed
+	void Update(const Actor* actor);
+	// catch up with any stats that changed behind our back
+	void Sync(const std::vector<Actor*>& actors);
+
+	const Buckets& GetBuckets(int slot) const { return buckets[slot]; }
+
+private:
+	struct Entry {
+		size_t index;
+		std::array<ieDword, STAT_COUNT> values;
+	};
+
+	std::array<Buckets, STAT_COUNT> buckets;
+	std::unordered_map<const Actor*, Entry> entries;
+};
+
+}
+
+#endif
@@ -22,6 +22,8 @@
 
 #include "Interface.h"
 
+#include <unordered_set>
+
 namespace GemRB {
 
 AnimationFactory::AnimationFactory(const ResRef& resref,
@@ -37,6 +39,15 @@ AnimationFactory::AnimationFactory(const ResRef& resref,
 	assert(cycles.size() < InvalidIndex);
 	assert(FLTable.size() < InvalidIndex);
 	fps = core->GetAnimationFPS(resRef);
+
+	// decoded size, RLE frames are smaller, but it is close enough for budgeting;
+	// cycles can share frames, which only take memory once
+	std::unordered_set<const Sprite2D*> counted;
+	for (const auto& frame : frames) {
+		if (frame && counted.insert(frame.get()).second) {
+			memorySize += frame->Frame.w * frame->Frame.h * frame->Format().Bpp;
+		}
+	}
 }
 
 Animation* AnimationFactory::GetCycle(index_t cycle) const noexcept
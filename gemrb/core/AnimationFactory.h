@@ -51,12 +51,14 @@ public:
 	index_t GetCycleCount() const { return cycles.size(); }
 	index_t GetFrameCount() const { return frames.size(); }
 	index_t GetCycleSize(index_t idx) const;
+	size_t GetMemorySize() const override { return memorySize; }
 
 private:
 	std::vector<Holder<Sprite2D>> frames;
 	std::vector<CycleEntry> cycles;
 	std::vector<index_t> FLTable; // Frame Lookup Table
 	float fps = ANI_DEFAULT_FRAMERATE; // comes from animfps.2da
+	size_t memorySize = 0;
 };
 
 }
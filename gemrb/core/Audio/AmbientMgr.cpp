@@ -72,7 +72,7 @@ void AmbientMgr::AmbientsSet(const std::vector<Ambient*>& a)
 	ambientSources.reserve(a.size());
 
 	for (auto& source : a) {
-		ambientSources.emplace_back(source, bufferCache);
+		ambientSources.emplace_back(source, bufferCache, decoder);
 	}
 }
 
@@ -116,6 +116,19 @@ void AmbientMgr::SetAmbients(const std::vector<Ambient*>& a)
 	Activate();
 }
 
+void AmbientMgr::Prefetch(const std::vector<Ambient*>& a)
+{
+	const auto& settings = core->GetAudioSettings();
+	for (const auto& ambient : a) {
+		// only the spatiality matters for decoding, see Tick for the real thing
+		bool loop = (ambient->GetFlags() & IE_AMBI_LOOPING) > 0;
+		auto config = ambient->GetFlags() & IE_AMBI_MAIN ? settings.ConfigPresetMainAmbient(ambient->GetGain(), loop) : settings.ConfigPresetPointAmbient(ambient->GetGain(), ambient->GetOrigin(), ambient->GetRadius(), loop);
+		for (const auto& sound : ambient->sounds) {
+			decoder.Queue(sound, config);
+		}
+	}
+}
+
 void AmbientMgr::Activate(StringView name)
 {
 	std::lock_guard<std::recursive_mutex> l(mutex);
@@ -301,25 +314,22 @@ tick_t AmbientMgr::AmbientSource::Tick(tick_t ticks, Point listener, ieDword tim
 
 BufferCacheEntry AmbientMgr::AmbientSource::GetBuffer(ResRef resource, const AudioPlaybackConfig& config)
 {
-	auto entry = bufferCache.get().Lookup(resource);
-	if (entry) {
-		return *entry;
+	decoder.get().Collect(bufferCache);
+	if (bufferCache.get().Touch(resource)) {
+		return *bufferCache.get().Lookup(resource);
 	}
 
-	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(resource);
-	if (!acm) {
-		return {};
+	BufferCacheEntry entry;
+	if (!decoder.get().Finish(resource, entry)) {
+		entry = SoundDecoder::Decode(resource, config);
 	}
-
-	auto length = acm->GetLengthMs();
-	auto handle = core->GetAudioDrv()->LoadSound(std::move(acm), config);
-	if (!handle) {
+	if (!entry.handle) {
 		return {};
 	}
 
-	bufferCache.get().SetAt(resource, std::move(handle), length);
+	bufferCache.get().SetAt(resource, entry);
 
-	return *bufferCache.get().Lookup(resource);
+	return entry;
 }
 
 // enqueues a random sound and returns its length
@@ -27,6 +27,7 @@
 #include "AudioBackend.h"
 #include "BufferCache.h"
 #include "Region.h"
+#include "SoundDecoder.h"
 
 #include <atomic>
 #include <condition_variable>
@@ -46,6 +47,8 @@ public:
 	void Reset();
 	void RemoveAmbients(const std::vector<Ambient*>& oldAmbients);
 	void SetAmbients(const std::vector<Ambient*>& a);
+	/** Decodes the sounds of these ambients in the background, ahead of their first play */
+	void Prefetch(const std::vector<Ambient*>& a);
 
 	void UpdateVolume();
 	void SetVolume(unsigned short value);
@@ -71,8 +74,8 @@ private:
 
 	class AmbientSource {
 	public:
-		explicit AmbientSource(const Ambient* a, AudioBufferCache& cache) noexcept
-			: ambient(a), bufferCache(cache) {};
+		explicit AmbientSource(const Ambient* a, AudioBufferCache& cache, SoundDecoder& decoder) noexcept
+			: ambient(a), bufferCache(cache), decoder(decoder) {};
 		AmbientSource(const AmbientSource&) = delete;
 		AmbientSource(AmbientSource&&) = default;
 		AmbientSource& operator=(const AmbientSource&) = delete;
@@ -86,6 +89,7 @@ private:
 	private:
 		const Ambient* ambient;
 		std::reference_wrapper<AudioBufferCache> bufferCache;
+		std::reference_wrapper<SoundDecoder> decoder;
 
 		Holder<SoundSourceHandle> source;
 		BufferCacheEntry bufferCacheEntry;
@@ -99,7 +103,8 @@ private:
 		tick_t Enqueue(const AudioPlaybackConfig& config);
 	};
 
-	AudioBufferCache bufferCache { 60 };
+	AudioBufferCache bufferCache { AMBIENT_CACHE_BYTES };
+	SoundDecoder decoder;
 	std::vector<AmbientSource> ambientSources;
 
 	int Play();
@@ -94,6 +94,7 @@ public:
 	virtual Holder<SoundStreamSourceHandle> CreateStreamable(
 		const AudioPlaybackConfig& config,
 		size_t minQueueSize = STREAM_QUEUE_MIN_SIZE) = 0;
+	// like the rest of the backend not thread-safe, SoundDecoder only decodes off-thread
 	virtual Holder<SoundBufferHandle> LoadSound(ResourceHolder<SoundMgr> resource, const AudioPlaybackConfig& config) = 0;
 
 	virtual const AudioPoint& GetListenerPosition() const = 0;
@@ -25,13 +25,18 @@
 
 namespace GemRB {
 
+// the default budgets, in decoded bytes
+static constexpr size_t SFX_CACHE_BYTES = 16 * 1024 * 1024;
+static constexpr size_t AMBIENT_CACHE_BYTES = 32 * 1024 * 1024;
+
 struct BufferCacheEntry {
 	Holder<SoundBufferHandle> handle;
 	time_t length = 0;
+	size_t size = 0; // decoded 16-bit PCM
 
 	BufferCacheEntry() = default;
-	explicit BufferCacheEntry(Holder<SoundBufferHandle> handle, time_t length)
-		: handle(std::move(handle)), length(length)
+	explicit BufferCacheEntry(Holder<SoundBufferHandle> handle, time_t length, size_t size)
+		: handle(std::move(handle)), length(length), size(size)
 	{}
 
 	void evictionNotice() const { /* No need. */ }
@@ -44,7 +49,14 @@ struct BufferInUse {
 	}
 };
 
-using AudioBufferCache = LRUCache<BufferCacheEntry, BufferInUse>;
+struct BufferSize {
+	size_t operator()(const BufferCacheEntry& entry) const
+	{
+		return entry.size;
+	}
+};
+
+using AudioBufferCache = LRUCache<BufferCacheEntry, BufferInUse, BufferSize>;
 
 }
 
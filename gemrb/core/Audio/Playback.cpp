@@ -104,20 +104,7 @@ Holder<PlaybackHandle> AudioPlayback::Play(StringView resource, const AudioPlayb
 		return {};
 	}
 
-	auto cacheEntry = GetBuffer(resource, config);
-	if (!cacheEntry.handle) {
-		return {};
-	}
-
-	auto source = core->GetAudioDrv()->CreatePlaybackSource(config);
-	if (!source) {
-		return {};
-	}
-	source->Enqueue(std::move(cacheEntry.handle));
-
-	activeSources.insert(source);
-
-	return MakeHolder<PlaybackHandle>(std::move(source), cacheEntry.length, config.position.z);
+	return Start(GetBuffer(resource, config), config);
 }
 
 Holder<PlaybackHandle> AudioPlayback::PlayDefaultSound(size_t index, SFXChannel channel)
@@ -134,20 +121,7 @@ Holder<PlaybackHandle> AudioPlayback::PlayDefaultSound(size_t index, const Audio
 	}
 
 	auto resource = defaultSounds[index];
-	auto cacheEntry = GetBuffer(resource, config);
-	if (!cacheEntry.handle) {
-		return {};
-	}
-
-	auto source = core->GetAudioDrv()->CreatePlaybackSource(config);
-	if (!source) {
-		return {};
-	}
-	source->Enqueue(std::move(cacheEntry.handle));
-
-	activeSources.insert(source);
-
-	return MakeHolder<PlaybackHandle>(std::move(source), cacheEntry.length, config.position.z);
+	return Start(GetBuffer(resource, config), config);
 }
 
 time_t AudioPlayback::PlaySpeech(StringView resource, const AudioPlaybackConfig& config, bool interrupt)
@@ -176,6 +150,59 @@ time_t AudioPlayback::PlaySpeech(StringView resource, const AudioPlaybackConfig&
 	return cacheEntry.length;
 }
 
+void AudioPlayback::PlayWhenReady(StringView resource, AudioPreset preset, SFXChannel channel, const Point& point)
+{
+	auto config = preset == AudioPreset::SpatialVoice ? core->GetAudioSettings().ConfigPresetSpatialVoice(channel, point) : core->GetAudioSettings().ConfigPresetByChannel(channel, point);
+
+	PlayWhenReady(resource, config);
+}
+
+void AudioPlayback::PlayWhenReady(StringView resource, const AudioPlaybackConfig& config)
+{
+	Housekeeping();
+
+	if (resource.empty()) {
+		return;
+	}
+
+	if (bufferCache.Touch(resource)) {
+		Start(*bufferCache.Lookup(resource), config);
+		return;
+	}
+
+	decoder.Queue(resource, config);
+	pendingPlays.push_back({ resource.c_str(), config, GetMilliseconds() + MAX_PLAY_DELAY });
+}
+
+void AudioPlayback::Prefetch(const std::vector<ResRef>& resources, const AudioPlaybackConfig& config)
+{
+	for (const auto& resource : resources) {
+		if (!resource.IsEmpty() && !bufferCache.Lookup(resource)) {
+			decoder.Queue(resource, config);
+		}
+	}
+}
+
+void AudioPlayback::Update()
+{
+	if (decoder.Collect(bufferCache) == 0 && pendingPlays.empty()) {
+		return;
+	}
+
+	tick_t now = GetMilliseconds();
+	for (auto it = pendingPlays.begin(); it != pendingPlays.end();) {
+		const BufferCacheEntry* cacheEntry = bufferCache.Lookup(it->resource);
+		if (cacheEntry) {
+			Start(*cacheEntry, it->config);
+		} else if (now <= it->deadline && decoder.IsPending(it->resource)) {
+			++it;
+			continue;
+		}
+		// started, too late or failed to decode
+		it = pendingPlays.erase(it);
+	}
+}
+
 void AudioPlayback::StopSpeech()
 {
 	if (speech) {
@@ -186,25 +213,40 @@ void AudioPlayback::StopSpeech()
 
 BufferCacheEntry AudioPlayback::GetBuffer(StringView resource, const AudioPlaybackConfig& config)
 {
-	auto cacheEntry = bufferCache.Lookup(resource);
-	if (cacheEntry) {
-		return *cacheEntry;
+	decoder.Collect(bufferCache);
+	if (bufferCache.Touch(resource)) {
+		return *bufferCache.Lookup(resource);
 	}
 
-	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(resource);
-	if (!acm) {
+	// a prefetch may already be on it
+	BufferCacheEntry cacheEntry;
+	if (!decoder.Finish(resource, cacheEntry)) {
+		cacheEntry = SoundDecoder::Decode(resource, config);
+	}
+	if (!cacheEntry.handle) {
 		return {};
 	}
 
-	auto length = acm->GetLengthMs();
-	auto handle = core->GetAudioDrv()->LoadSound(std::move(acm), config);
-	if (!handle) {
+	bufferCache.SetAt(resource, cacheEntry);
+
+	return cacheEntry;
+}
+
+Holder<PlaybackHandle> AudioPlayback::Start(BufferCacheEntry cacheEntry, const AudioPlaybackConfig& config)
+{
+	if (!cacheEntry.handle) {
 		return {};
 	}
 
-	bufferCache.SetAt(resource, std::move(handle), length);
+	auto source = core->GetAudioDrv()->CreatePlaybackSource(config);
+	if (!source) {
+		return {};
+	}
+	source->Enqueue(std::move(cacheEntry.handle));
+
+	activeSources.insert(source);
 
-	return *bufferCache.Lookup(resource);
+	return MakeHolder<PlaybackHandle>(std::move(source), cacheEntry.length, config.position.z);
 }
 
 void AudioPlayback::Housekeeping()
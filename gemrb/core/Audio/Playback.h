@@ -23,7 +23,9 @@
 #include "AudioBackend.h"
 #include "AudioSettings.h"
 #include "BufferCache.h"
+#include "SoundDecoder.h"
 
+#include <list>
 #include <set>
 #include <vector>
 
@@ -61,8 +63,27 @@ public:
 	time_t PlaySpeech(StringView resource, const AudioPlaybackConfig& config, bool interrupt = true);
 	void StopSpeech();
 
+	// fire and forget: starts right away if decoded, otherwise once the decoder is done with it
+	void PlayWhenReady(StringView resource, AudioPreset preset, SFXChannel channel, const Point& point);
+	void PlayWhenReady(StringView resource, const AudioPlaybackConfig& config);
+	/** Decodes the sounds in the background, so their first play doesn't have to */
+	void Prefetch(const std::vector<ResRef>& resources, const AudioPlaybackConfig& config);
+	/** Picks up finished decodes and starts the plays waiting for them, once per frame */
+	void Update();
+
 private:
-	AudioBufferCache bufferCache { 40 };
+	struct PendingPlay {
+		std::string resource;
+		AudioPlaybackConfig config;
+		tick_t deadline;
+	};
+
+	// a late sound is worse than none, eg. a swing heard after the hit
+	static constexpr tick_t MAX_PLAY_DELAY = 500;
+
+	AudioBufferCache bufferCache { SFX_CACHE_BYTES };
+	SoundDecoder decoder;
+	std::list<PendingPlay> pendingPlays;
 	Holder<SoundSourceHandle> speech;
 	std::set<Holder<SoundSourceHandle>> activeSources;
 
@@ -70,6 +91,7 @@ private:
 
 	void Housekeeping();
 	BufferCacheEntry GetBuffer(StringView resource, const AudioPlaybackConfig& config);
+	Holder<PlaybackHandle> Start(BufferCacheEntry cacheEntry, const AudioPlaybackConfig& config);
 };
 
 }
@@ -0,0 +1,231 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "SoundDecoder.h"
+
+#include "Interface.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace GemRB {
+
+// fully decoded interleaved 16-bit samples, handed to the backend like any sound resource
+class DecodedSound : public SoundMgr {
+	std::vector<short> pcm;
+	size_t pos = 0;
+
+	bool Import(DataStream*) override { return false; }
+
+public:
+	explicit DecodedSound(SoundMgr& source)
+	{
+		samples = source.GetNumSamples();
+		channels = source.GetChannels();
+		sampleRate = source.GetSampleRate();
+		pcm.resize(samples);
+		pcm.resize(source.read_samples(pcm.data(), samples));
+	}
+
+	size_t read_samples(short* memory, size_t cnt) override
+	{
+		cnt = std::min(cnt, pcm.size() - pos);
+		std::copy_n(pcm.begin() + pos, cnt, memory);
+		pos += cnt;
+		return cnt;
+	}
+
+	// like the readers, returns the number of samples per channel
+	size_t ReadSamplesIntoChannels(char* channel1, char* channel2, size_t numSamples) override
+	{
+		size_t frames = std::min(numSamples, (pcm.size() - pos) / 2);
+		short* left = reinterpret_cast<short*>(channel1);
+		short* right = reinterpret_cast<short*>(channel2);
+		for (size_t i = 0; i < frames; ++i) {
+			left[i] = pcm[pos + 2 * i];
+			right[i] = pcm[pos + 2 * i + 1];
+		}
+		pos += frames * 2;
+		return frames;
+	}
+};
+
+SoundDecoder::~SoundDecoder()
+{
+	{
+		std::lock_guard<std::mutex> l(jobLock);
+		stopping = true;
+	}
+	jobCV.notify_all();
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+BufferCacheEntry SoundDecoder::Decode(StringView resource, const AudioPlaybackConfig& config)
+{
+	return Upload(gamedata->GetResourceHolder<SoundMgr>(resource), config);
+}
+
+// the only part done on the worker
+ResourceHolder<SoundMgr> SoundDecoder::DecodePCM(StringView resource)
+{
+	ResourceHolder<SoundMgr> acm = gamedata->GetResourceHolder<SoundMgr>(resource);
+	if (!acm) {
+		return nullptr;
+	}
+	return std::make_shared<DecodedSound>(*acm);
+}
+
+// backends are not thread-safe, so this has to run on the owner's thread
+BufferCacheEntry SoundDecoder::Upload(ResourceHolder<SoundMgr> sound, const AudioPlaybackConfig& config)
+{
+	if (!sound) {
+		return {};
+	}
+
+	auto length = sound->GetLengthMs();
+	size_t size = sound->GetNumSamples() * 2;
+	auto handle = core->GetAudioDrv()->LoadSound(std::move(sound), config);
+	if (!handle) {
+		return {};
+	}
+
+	return BufferCacheEntry(std::move(handle), length, size);
+}
+
+void SoundDecoder::Queue(StringView resource, const AudioPlaybackConfig& config)
+{
+	if (resource.empty()) {
+		return;
+	}
+
+	std::string key { resource.c_str() };
+	{
+		std::lock_guard<std::mutex> l(jobLock);
+		if (!jobs.emplace(key, Job(config)).second) {
+			return;
+		}
+		queue.push_back(std::move(key));
+
+		// one thread is plenty, decodes are short and the disk is shared anyway
+		if (!worker.joinable()) {
+			worker = std::thread(&SoundDecoder::Work, this);
+		}
+	}
+	jobCV.notify_all();
+}
+
+size_t SoundDecoder::Collect(AudioBufferCache& cache)
+{
+	std::vector<std::pair<std::string, Job>> done;
+	{
+		std::lock_guard<std::mutex> l(jobLock);
+		for (auto it = jobs.begin(); it != jobs.end();) {
+			if (it->second.state != JobState::Done) {
+				++it;
+				continue;
+			}
+			done.emplace_back(it->first, std::move(it->second));
+			it = jobs.erase(it);
+		}
+	}
+
+	// failed decodes are dropped, so anyone waiting on them gives up
+	for (auto& job : done) {
+		BufferCacheEntry entry = Upload(std::move(job.second.pcm), job.second.config);
+		if (entry.handle) {
+			cache.SetAt(job.first, std::move(entry));
+		}
+	}
+	return done.size();
+}
+
+bool SoundDecoder::Finish(StringView resource, BufferCacheEntry& entry)
+{
+	std::string key { resource.c_str() };
+	std::unique_lock<std::mutex> l(jobLock);
+	auto job = jobs.find(key);
+	if (job == jobs.end()) {
+		return false;
+	}
+
+	if (job->second.state == JobState::Queued) {
+		// not started yet, so it is quicker to do it here than to wait in line
+		// the worker skips queue entries without a job
+		AudioPlaybackConfig config = job->second.config;
+		jobs.erase(job);
+		l.unlock();
+		entry = Decode(resource, config);
+		return true;
+	}
+
+	jobCV.wait(l, [this, &key]() {
+		auto it = jobs.find(key);
+		return it == jobs.end() || it->second.state == JobState::Done;
+	});
+	job = jobs.find(key);
+	if (job == jobs.end()) {
+		return false;
+	}
+	ResourceHolder<SoundMgr> pcm = std::move(job->second.pcm);
+	AudioPlaybackConfig config = job->second.config;
+	jobs.erase(job);
+	l.unlock();
+	entry = Upload(std::move(pcm), config);
+	return true;
+}
+
+bool SoundDecoder::IsPending(StringView resource) const
+{
+	std::lock_guard<std::mutex> l(jobLock);
+	auto job = jobs.find(resource.c_str());
+	return job != jobs.end() && job->second.state != JobState::Done;
+}
+
+void SoundDecoder::Work()
+{
+	std::unique_lock<std::mutex> l(jobLock);
+	while (true) {
+		jobCV.wait(l, [this]() { return stopping || !queue.empty(); });
+		if (stopping) {
+			return;
+		}
+
+		std::string key = std::move(queue.front());
+		queue.pop_front();
+		auto job = jobs.find(key);
+		if (job == jobs.end() || job->second.state != JobState::Queued) {
+			continue;
+		}
+		job->second.state = JobState::Decoding;
+
+		l.unlock();
+		ResourceHolder<SoundMgr> pcm = DecodePCM(key);
+		l.lock();
+
+		// nobody erases a job while it is being decoded
+		job = jobs.find(key);
+		job->second.pcm = std::move(pcm);
+		job->second.state = JobState::Done;
+		jobCV.notify_all();
+	}
+}
+
+}
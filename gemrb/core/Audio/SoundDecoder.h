@@ -0,0 +1,97 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef H_AUDIO_SOUND_DECODER
+#define H_AUDIO_SOUND_DECODER
+
+#include "exports.h"
+
+#include "BufferCache.h"
+#include "PlaybackConfig.h"
+#include "SoundMgr.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace GemRB {
+
+/**
+ * Decodes sounds into PCM on a worker thread, so that first plays don't
+ * stall the caller. The worker never touches the audio backend: the owner
+ * turns the PCM into backend buffers on its own thread when it moves them
+ * into its (not thread-safe) buffer cache with Collect or Finish.
+ */
+class GEM_EXPORT SoundDecoder {
+public:
+	SoundDecoder() noexcept = default;
+	SoundDecoder(const SoundDecoder&) = delete;
+	~SoundDecoder();
+	SoundDecoder& operator=(const SoundDecoder&) = delete;
+
+	/** Loads and decodes a sound on the calling thread */
+	static BufferCacheEntry Decode(StringView resource, const AudioPlaybackConfig& config);
+
+	/** Queues a decode, unless the resource is already queued, being decoded or waiting for collection */
+	void Queue(StringView resource, const AudioPlaybackConfig& config);
+	/** Moves the finished decodes into the cache, returns how many there were */
+	size_t Collect(AudioBufferCache& cache);
+	/**
+	 * Gets a queued sound now: decodes it here if the worker has not started on it yet,
+	 * otherwise waits for the worker. Returns false if it was never queued.
+	 */
+	bool Finish(StringView resource, BufferCacheEntry& entry);
+	/** True while the resource is queued or being decoded */
+	bool IsPending(StringView resource) const;
+
+private:
+	enum class JobState {
+		Queued,
+		Decoding,
+		Done
+	};
+
+	struct Job {
+		JobState state = JobState::Queued;
+		AudioPlaybackConfig config;
+		ResourceHolder<SoundMgr> pcm; // null if the decode failed
+
+		explicit Job(const AudioPlaybackConfig& config)
+			: config(config) {}
+	};
+
+	static ResourceHolder<SoundMgr> DecodePCM(StringView resource);
+	static BufferCacheEntry Upload(ResourceHolder<SoundMgr> sound, const AudioPlaybackConfig& config);
+	void Work();
+
+	// keyed like the buffer cache
+	std::unordered_map<std::string, Job> jobs;
+	std::deque<std::string> queue;
+	std::thread worker;
+	mutable std::mutex jobLock;
+	std::condition_variable jobCV;
+	bool stopping = false;
+};
+
+}
+
+#endif
@@ -167,6 +167,22 @@ public:
 	{
 		std::fill(begin(), end(), pattern);
 	}
+
+	// sets or clears the count bits from bit start on, whole bytes at a time where possible
+	void FillSpan(int start, int count, bool set) noexcept
+	{
+		int stop = start + count;
+		for (; start < stop && start % 8; ++start) {
+			operator[](start) = set;
+		}
+		if (stop / 8 > start / 8) {
+			std::fill(data + start / 8, data + stop / 8, set ? 0xff : 0x00);
+			start = stop / 8 * 8;
+		}
+		for (; start < stop; ++start) {
+			operator[](start) = set;
+		}
+	}
 };
 
 }
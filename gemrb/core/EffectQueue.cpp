@@ -42,6 +42,8 @@
 #include "Logging/Logging.h"
 #include "Scriptable/Actor.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 static std::vector<EffectDesc> effectnames;
@@ -442,12 +444,89 @@ Effect* EffectQueue::CreateUnsummonEffect(const Effect* fx)
 	return newfx;
 }
 
+EffectQueue::EffectQueue(const EffectQueue& other)
+	: effects(other.effects), Owner(other.Owner)
+{
+	RebuildIndex();
+}
+
+EffectQueue::EffectQueue(EffectQueue&& other) noexcept
+	: effects(std::move(other.effects)), opcodeIndex(std::move(other.opcodeIndex)), Owner(other.Owner)
+{
+	other.opcodeIndex.clear();
+}
+
+EffectQueue& EffectQueue::operator=(const EffectQueue& other)
+{
+	if (&other != this) {
+		effects = other.effects;
+		Owner = other.Owner;
+		RebuildIndex();
+	}
+	return *this;
+}
+
+EffectQueue& EffectQueue::operator=(EffectQueue&& other) noexcept
+{
+	if (&other != this) {
+		effects = std::move(other.effects);
+		opcodeIndex = std::move(other.opcodeIndex);
+		other.opcodeIndex.clear();
+		Owner = other.Owner;
+	}
+	return *this;
+}
+
+EffectQueue::OpcodeView<Effect> EffectQueue::OpcodeEffects(ieDword opcode)
+{
+	auto bucket = opcodeIndex.find(opcode);
+	return OpcodeView<Effect>(bucket == opcodeIndex.end() ? nullptr : &bucket->second);
+}
+
+EffectQueue::OpcodeView<const Effect> EffectQueue::OpcodeEffects(ieDword opcode) const
+{
+	auto bucket = opcodeIndex.find(opcode);
+	return OpcodeView<const Effect>(bucket == opcodeIndex.end() ? nullptr : &bucket->second);
+}
+
+void EffectQueue::IndexEffect(Effect* fx, bool insert)
+{
+	auto& bucket = opcodeIndex[fx->Opcode];
+	if (insert) {
+		bucket.push_front(fx);
+	} else {
+		bucket.push_back(fx);
+	}
+}
+
+void EffectQueue::UnindexEffect(const Effect* fx, ieDword opcode)
+{
+	auto bucket = opcodeIndex.find(opcode);
+	if (bucket == opcodeIndex.end()) return;
+
+	auto& fxs = bucket->second;
+	auto it = std::find(fxs.begin(), fxs.end(), fx);
+	if (it == fxs.end()) return;
+	fxs.erase(it);
+}
+
+void EffectQueue::RebuildIndex()
+{
+	// keep the buckets, the same opcodes usually come back
+	for (auto& bucket : opcodeIndex) {
+		bucket.second.clear();
+	}
+	for (auto& fx : effects) {
+		IndexEffect(&fx, false);
+	}
+}
+
 void EffectQueue::AddEffect(Effect* fx, bool insert)
 {
 	if (insert) {
-		effects.push_front(std::move(*fx));
+		IndexEffect(&effects.push_front(*fx), true);
 	} else {
-		effects.push_back(std::move(*fx));
+		IndexEffect(&effects.push_back(*fx), false);
 	}
 	delete fx;
 }
@@ -458,6 +537,7 @@ bool EffectQueue::RemoveEffect(const Effect* fx)
 {
 	for (auto f = effects.begin(); f != effects.end(); ++f) {
 		if (*fx == *f) {
+			UnindexEffect(&*f, f->Opcode);
 			effects.erase(f);
 			return true;
 		}
@@ -473,26 +553,86 @@ void EffectQueue::ApplyAllEffects(Actor* target)
 	const auto& Opcodes = Globals::Get().Opcodes;
 
 	for (auto& fx : effects) {
+		ieDword opcode = fx.Opcode;
 		if (Opcodes[fx.Opcode].Flags & EFFECT_REINIT_ON_LOAD) {
 			// pretend to be the first application (FirstApply==1)
 			ApplyEffect(target, &fx, 1);
 		} else {
 			ApplyEffect(target, &fx, 0);
 		}
+
+		// some effects turn into others when applied
+		if (fx.Opcode != opcode) {
+			RebuildIndex();
+		}
 	}
 }
 
-void EffectQueue::Cleanup()
+bool EffectQueue::GetStatDependencies(StatDependencies& deps) const
 {
-	for (auto f = effects.begin(); f != effects.end();) {
-		if (f->TimingMode == FX_DURATION_JUST_EXPIRED) {
-			f = effects.erase(f);
+	const auto& Opcodes = Globals::Get().Opcodes;
+	ieDword gameTime = core->GetGame()->GameTime;
+
+	// keep the entries around, so refreshing doesn't allocate again
+	for (auto& stat : deps) {
+		stat.second.clear();
+	}
+
+	for (const auto& fx : effects) {
+		if (fx.TimingMode == FX_DURATION_JUST_EXPIRED) continue;
+		if (fx.Opcode >= Globals::MAX_EFFECTS || Opcodes[fx.Opcode].Stat < 0) {
+			return false;
+		}
+		// first applications and base stat changes are one-off
+		if (fx.FirstApply || fx.TimingMode == FX_DURATION_INSTANT_PERMANENT) {
+			return false;
+		}
+		// the effect would trigger or expire
+		switch (DelayType(fx.TimingMode)) {
+			case TimingType::Permanent:
+				break;
+			case TimingType::Delayed:
+			case TimingType::Duration:
+				if (fx.Duration <= gameTime) return false;
+				break;
+			default:
+				return false;
+		}
+
+		deps[Opcodes[fx.Opcode].Stat].emplace_back(fx);
+	}
+
+	for (auto stat = deps.begin(); stat != deps.end();) {
+		if (stat->second.empty()) {
+			stat = deps.erase(stat);
 		} else {
-			++f;
+			++stat;
+		}
+	}
+	return true;
+}
+
+void EffectQueue::ApplyStatEffects(Actor* target, const StatSet& stats)
+{
+	const auto& Opcodes = Globals::Get().Opcodes;
+
+	for (auto& fx : effects) {
+		if (fx.Opcode >= Globals::MAX_EFFECTS) continue;
+		int stat = Opcodes[fx.Opcode].Stat;
+		if (stat >= 0 && stats[stat]) {
+			ApplyEffect(target, &fx, 0);
 		}
 	}
 }
 
+void EffectQueue::Cleanup()
+{
+	// closing the gaps moves the effects, so the index has to follow
+	if (effects.Compact([](const Effect& fx) { return fx.TimingMode == FX_DURATION_JUST_EXPIRED; })) {
+		RebuildIndex();
+	}
+}
+
 //Handle the target flag when the effect is applied first
 int EffectQueue::AddEffect(Effect* fx, Scriptable* self, Actor* pretarget, const Point& dest) const
 {
@@ -1336,13 +1476,6 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 	return res;
 }
 
-// looks for opcode with param2
-
-#define MATCH_OPCODE() \
-	if (fx.Opcode != opcode) { \
-		continue; \
-	}
-
 // useful for: remove projectile type
 #define MATCH_PROJECTILE() \
 	if (fx.Projectile != projectile) { \
@@ -1377,8 +1510,7 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		fx.TimingMode = FX_DURATION_JUST_EXPIRED;
@@ -1554,8 +1686,7 @@ void EffectQueue::RemoveAllEffects(EffectRef& effectReference)
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ResRef& resource)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) {
 			continue;
@@ -1575,8 +1706,7 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef& effectReference, const
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithSource(ieDword opcode, const ResRef& source, int mode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		if (fx.SourceRef != source) continue;
 
 		// equipping effects only
@@ -1606,8 +1736,7 @@ void EffectQueue::RemoveAllEffectsWithSource(EffectRef& effectReference, const R
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		switch (fx.Parameter2) {
@@ -1643,8 +1772,7 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef& effectReference, ieDwor
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param, bool param1)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (param1) {
 			if (fx.Parameter1 != param) continue;
@@ -1672,8 +1800,7 @@ void EffectQueue::RemoveAllEffectsWithParam1(EffectRef& effectReference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ResRef& resource)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 
@@ -1802,8 +1929,7 @@ bool EffectQueue::RollDispelChance(ieDword casterLevel, ieDword level)
 
 const Effect* EffectQueue::HasOpcode(ieDword opcode) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		return &fx;
@@ -1822,8 +1948,7 @@ const Effect* EffectQueue::HasEffect(EffectRef& effectReference) const
 
 Effect* EffectQueue::HasOpcode(ieDword opcode)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		return &fx;
@@ -1842,8 +1967,7 @@ Effect* EffectQueue::HasEffect(EffectRef& effectReference)
 
 const Effect* EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 
@@ -1867,8 +1991,7 @@ const Effect* EffectQueue::HasEffectWithParam(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		//0 is always accepted as first parameter
@@ -1895,8 +2018,7 @@ const Effect* EffectQueue::HasEffectWithParamPair(EffectRef& effectReference, ie
 bool EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount)
 {
 	bool found = false;
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		ieDword& amount_left = fx.Parameter1;
 		if (amount_left > amount) {
@@ -1923,8 +2045,7 @@ bool EffectQueue::DecreaseParam1OfEffect(EffectRef& effectReference, ieDword amo
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		ieDword value = fx.Parameter3;
@@ -1962,8 +2083,7 @@ static const int ids_stats[9] = { IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RAC
 int EffectQueue::BonusAgainstCreature(ieDword opcode, const Actor* actor) const
 {
 	ieDword sum = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Parameter1) {
 			ieDword param1;
@@ -2014,8 +2134,7 @@ int EffectQueue::BonusAgainstCreature(EffectRef& effectReference, const Actor* a
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
 	int sum = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		MATCH_PARAM2()
 		sum += fx.Parameter1;
@@ -2036,8 +2155,7 @@ int EffectQueue::MaxParam1(ieDword opcode, bool positive) const
 {
 	int max = 0;
 	ieDwordSigned param1 = 0;
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		param1 = signed(fx.Parameter1);
@@ -2059,8 +2177,7 @@ int EffectQueue::MaxParam1(EffectRef& effectReference, bool positive) const
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		int magic = (int) fx.Parameter1;
@@ -2099,8 +2216,7 @@ void EffectQueue::AddWeaponEffects(EffectQueue* fxqueue, EffectRef& fx_ref, ieDw
 	ieDword opcode = fx_ref.opcode;
 	Point p(-1, -1);
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (!param2 && fx.Parameter2 != param2) continue;
 
@@ -2119,8 +2235,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 	int remaining = 0;
 	int count = 0;
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 
 		count++;
@@ -2140,8 +2255,7 @@ int EffectQueue::SumDamageReduction(EffectRef& effectReference, ieDword weaponEn
 //useful for immunity vs spell, can't use item, etc.
 const Effect* EffectQueue::HasOpcodeWithResource(ieDword opcode, const ResRef& resource) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (fx.Resource != resource) continue;
 
@@ -2165,8 +2279,7 @@ const Effect* EffectQueue::HasEffectWithPower(EffectRef& effectReference, ieDwor
 
 const Effect* EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		// NOTE: matching greater or equals!
 		if (fx.Power < power) continue;
@@ -2193,8 +2306,7 @@ const Effect* EffectQueue::HasSource(const ResRef& removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 const Effect* EffectQueue::HasOpcodeWithSource(ieDword opcode, const ResRef& removed) const
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (removed != fx.SourceRef) {
 			continue;
@@ -2278,18 +2390,23 @@ Effect* EffectQueue::GetNextEffect(queue_t::iterator& f)
 
 ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2, const ResRef& resource, const ResRef& source) const
 {
-	ieDword cnt = 0;
+	auto matches = [&](const Effect& fx) {
+		if (param1 != 0xffffffff && fx.Parameter1 != param1) return false;
+		if (param2 != 0xffffffff && fx.Parameter2 != param2) return false;
+		if (!resource.IsEmpty() && fx.Resource != resource) return false;
+		if (!source.IsEmpty() && fx.SourceRef != source) return false;
+		return true;
+	};
 
-	for (const auto& fx : effects) {
-		if (opcode != 0xffffffff)
-			MATCH_OPCODE()
-		if (param1 != 0xffffffff)
-			MATCH_PARAM1()
-		if (param2 != 0xffffffff)
-			MATCH_PARAM2()
-		if (!resource.IsEmpty() && fx.Resource != resource) continue;
-		if (!source.IsEmpty() && fx.SourceRef != source) continue;
-		cnt++;
+	ieDword cnt = 0;
+	if (opcode == 0xffffffff) {
+		for (const auto& fx : effects) {
+			if (matches(fx)) cnt++;
+		}
+	} else {
+		for (const auto& fx : OpcodeEffects(opcode)) {
+			if (matches(fx)) cnt++;
+		}
 	}
 	return cnt;
 }
@@ -2299,8 +2416,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 	ieDword cnt = 1;
 	ieDword opcode = ResolveEffect(effectReference);
 
-	for (const auto& fx : effects) {
-		MATCH_OPCODE()
+	for (const auto& fx : OpcodeEffects(opcode)) {
 		MATCH_LIVE_FX()
 		if (&fx == fx2) break;
 		cnt++;
@@ -2310,8 +2426,7 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effectReference, const Effec
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y)
 {
-	for (auto& fx : effects) {
-		MATCH_OPCODE()
+	for (auto& fx : OpcodeEffects(opcode)) {
 		fx.Pos = Point(x, y);
 		fx.Parameter3 = 0;
 		return;
@@ -31,9 +31,14 @@
 #include "exports.h"
 
 #include "Effect.h"
+#include "EffectStore.h"
 
+#include <bitset>
 #include <cstdlib>
-#include <list>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace GemRB {
 
@@ -138,12 +143,14 @@ public:
 	const char* Name = nullptr; // FIXME: shouldn't we presume ownership of the name? original implementation didn't
 	int Flags = 0;
 	int opcode = -1;
+	// the only stat the handler changes (without post change functions), -1 if it does anything else
+	int Stat = -1;
 	ieStrRef Strref = ieStrRef::INVALID;
 
 	EffectDesc() = default;
 
-	EffectDesc(const char* name, EffectFunction fn, int flags, int data)
-		: Function(fn), Name(name), Flags(flags), opcode(data) {};
+	EffectDesc(const char* name, EffectFunction fn, int flags, int data, int stat = -1)
+		: Function(fn), Name(name), Flags(flags), opcode(data), Stat(stat) {};
 
 	explicit operator bool() const
 	{
@@ -209,13 +216,80 @@ bool IsColorslotEffect(int opcode);
 class GEM_EXPORT EffectQueue {
 private:
 	/** List of Effects applied on the Actor */
-	using queue_t = std::list<Effect>;
+	using queue_t = EffectStore;
 	queue_t effects;
+	/** The same Effects grouped by opcode, each group in queue order */
+	using opcode_index_t = std::unordered_map<ieDword, std::deque<Effect*>>;
+	opcode_index_t opcodeIndex;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner = nullptr;
 
+	/** Iterates the Effects of a single opcode, without walking the whole queue */
+	template<typename T>
+	class OpcodeView {
+		using bucket_t = std::deque<Effect*>;
+		const bucket_t* bucket;
+
+	public:
+		class iterator {
+			bucket_t::const_iterator it;
+
+		public:
+			explicit iterator(bucket_t::const_iterator it) noexcept
+				: it(it) {}
+			T& operator*() const { return **it; }
+			iterator& operator++()
+			{
+				++it;
+				return *this;
+			}
+			bool operator!=(const iterator& rhs) const { return it != rhs.it; }
+		};
+
+		explicit OpcodeView(const bucket_t* bucket) noexcept
+			: bucket(bucket) {}
+		iterator begin() const { return iterator(bucket ? bucket->begin() : bucket_t::const_iterator()); }
+		iterator end() const { return iterator(bucket ? bucket->end() : bucket_t::const_iterator()); }
+	};
+
+	OpcodeView<Effect> OpcodeEffects(ieDword opcode);
+	OpcodeView<const Effect> OpcodeEffects(ieDword opcode) const;
+	void IndexEffect(Effect* fx, bool insert);
+	void UnindexEffect(const Effect* fx, ieDword opcode);
+	void RebuildIndex();
+
 public:
+	/** Everything the result of an effect with a Stat depends on, besides the stat itself */
+	struct StatEffectKey {
+		ieDword Opcode = 0;
+		ieDword Parameter1 = 0;
+		ieDword Parameter2 = 0;
+		ieDword Parameter3 = 0;
+		ieDword TimingMode = 0;
+		ieWord IsVariable = 0;
+		ResRef Resource;
+
+		explicit StatEffectKey(const Effect& fx) noexcept
+			: Opcode(fx.Opcode), Parameter1(fx.Parameter1), Parameter2(fx.Parameter2), Parameter3(fx.Parameter3),
+			  TimingMode(fx.TimingMode), IsVariable(fx.IsVariable), Resource(fx.Resource) {}
+
+		bool operator==(const StatEffectKey& other) const noexcept
+		{
+			return Opcode == other.Opcode && Parameter1 == other.Parameter1 && Parameter2 == other.Parameter2 &&
+				Parameter3 == other.Parameter3 && TimingMode == other.TimingMode && IsVariable == other.IsVariable &&
+				Resource == other.Resource;
+		}
+		bool operator!=(const StatEffectKey& other) const noexcept { return !(*this == other); }
+	};
+	/** The effects modifying each stat, in queue order */
+	using StatDependencies = std::map<ieDword, std::vector<StatEffectKey>>;
+	using StatSet = std::bitset<256>; // MAX_STATS
+
 	EffectQueue() noexcept {};
+	EffectQueue(const EffectQueue& other);
+	EffectQueue(EffectQueue&& other) noexcept;
+	EffectQueue& operator=(const EffectQueue& other);
+	EffectQueue& operator=(EffectQueue&& other) noexcept;
 
 	explicit operator bool() const
 	{
@@ -238,6 +312,12 @@ public:
 
 	int AddAllEffects(Actor* target, const Point& dest);
 	void ApplyAllEffects(Actor* target);
+	/** Collects the effects modifying each stat, in queue order, if reapplying the queue
+	 * would only redo the same stat changes (all effects have a Stat and none is due to
+	 * change state). Returns false otherwise */
+	bool GetStatDependencies(StatDependencies& deps) const;
+	/** Reapplies only the effects modifying the given stats */
+	void ApplyStatEffects(Actor* target, const StatSet& stats);
 	/** remove effects marked for removal */
 	void Cleanup();
 
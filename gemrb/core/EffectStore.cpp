@@ -0,0 +1,123 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "EffectStore.h"
+
+#include <utility>
+
+namespace GemRB {
+
+EffectStore::EffectStore(const EffectStore& other)
+{
+	operator=(other);
+}
+
+EffectStore::EffectStore(EffectStore&& other) noexcept
+{
+	operator=(std::move(other));
+}
+
+EffectStore& EffectStore::operator=(EffectStore&& other) noexcept
+{
+	if (&other != this) {
+		chunks = std::move(other.chunks);
+		first = other.first;
+		used = other.used;
+		frontInserts = other.frontInserts;
+		live = other.live;
+
+		other.chunks.clear();
+		other.first = 0;
+		other.used = 0;
+		other.frontInserts = 0;
+		other.live = 0;
+	}
+	return *this;
+}
+
+EffectStore& EffectStore::operator=(const EffectStore& other)
+{
+	if (&other != this) {
+		clear();
+		for (const Effect& fx : other) {
+			push_back(fx);
+		}
+	}
+	return *this;
+}
+
+Effect& EffectStore::push_front(const Effect& fx)
+{
+	if (first == 0) {
+		chunks.emplace_front(new Chunk());
+		first = CHUNK_SIZE;
+	}
+	--first;
+	++used;
+	++frontInserts;
+	++live;
+	SetLive(0, true);
+	Effect* slot = Slot(0);
+	*slot = fx;
+	return *slot;
+}
+
+Effect& EffectStore::push_back(const Effect& fx)
+{
+	if (first + used == capacity()) {
+		chunks.emplace_back(new Chunk());
+	}
+	++used;
+	++live;
+	SetLive(used - 1, true);
+	Effect* slot = Slot(used - 1);
+	*slot = fx;
+	return *slot;
+}
+
+void EffectStore::erase(const iterator& it)
+{
+	SetLive(it.Index(), false);
+	--live;
+}
+
+// frees the chunks outside the used range, but keeps one around for the next effect
+void EffectStore::Trim()
+{
+	if (!used) {
+		first = 0;
+	}
+	while (first + used + CHUNK_SIZE <= capacity() && chunks.size() > 1) {
+		chunks.pop_back();
+	}
+}
+
+void EffectStore::clear()
+{
+	for (size_t index = 0; index < used; ++index) {
+		SetLive(index, false);
+	}
+	used = 0;
+	frontInserts = 0;
+	live = 0;
+	Trim();
+}
+
+}
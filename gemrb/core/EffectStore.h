@@ -0,0 +1,184 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef EFFECTSTORE_H
+#define EFFECTSTORE_H
+
+#include "exports.h"
+
+#include "Effect.h"
+
+#include <bitset>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+
+namespace GemRB {
+
+/**
+ * @class EffectStore
+ * Ordered storage for the Effects of an EffectQueue.
+ * Effects sit in queue order in fixed-size chunks, which are added at either
+ * end as the store grows, so iteration walks them in place. Erased entries
+ * are only marked and skipped until Compact() closes the gaps.
+ * Like with a list, iterators and Effect pointers survive insertions at either
+ * end and erasure of other entries, and effects appended during iteration are
+ * still visited. Compact() moves the effects, invalidating both.
+ */
+
+class GEM_EXPORT EffectStore {
+	static constexpr size_t CHUNK_SIZE = 8;
+
+	struct Chunk {
+		Effect slots[CHUNK_SIZE];
+		std::bitset<CHUNK_SIZE> live;
+	};
+
+	std::deque<std::unique_ptr<Chunk>> chunks;
+	// slot of the first entry in the front chunk
+	size_t first = 0;
+	// entries from there on, erased ones included
+	size_t used = 0;
+	// entries pushed to the front since the last Compact(); iterators
+	// store positions relative to it, so they don't shift with them
+	size_t frontInserts = 0;
+	size_t live = 0;
+
+	Chunk& ChunkAt(size_t index) const { return *chunks[(first + index) / CHUNK_SIZE]; }
+	Effect* Slot(size_t index) const { return &ChunkAt(index).slots[(first + index) % CHUNK_SIZE]; }
+	bool IsLive(size_t index) const { return ChunkAt(index).live[(first + index) % CHUNK_SIZE]; }
+	void SetLive(size_t index, bool value) { ChunkAt(index).live[(first + index) % CHUNK_SIZE] = value; }
+	void Trim();
+
+public:
+	template<typename T>
+	class Iterator {
+		friend class EffectStore;
+		static constexpr ptrdiff_t END = std::numeric_limits<ptrdiff_t>::max() / 2;
+
+		const EffectStore* store = nullptr;
+		ptrdiff_t pos = END;
+
+		ptrdiff_t Index() const { return pos + ptrdiff_t(store->frontInserts); }
+		bool IsEnd() const { return !store || Index() >= ptrdiff_t(store->used); }
+		void SkipErased()
+		{
+			while (!IsEnd() && !store->IsLive(Index())) {
+				++pos;
+			}
+		}
+
+	public:
+		Iterator() noexcept = default;
+		Iterator(const EffectStore* store, ptrdiff_t pos) noexcept
+			: store(store), pos(pos)
+		{
+			SkipErased();
+		}
+
+		T& operator*() const { return *store->Slot(Index()); }
+		T* operator->() const { return store->Slot(Index()); }
+
+		Iterator& operator++()
+		{
+			++pos;
+			SkipErased();
+			return *this;
+		}
+		Iterator operator++(int)
+		{
+			Iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			if (IsEnd() || rhs.IsEnd()) return IsEnd() == rhs.IsEnd();
+			return Index() == rhs.Index();
+		}
+		bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+	};
+
+	using iterator = Iterator<Effect>;
+	using const_iterator = Iterator<const Effect>;
+
+	EffectStore() noexcept = default;
+	EffectStore(const EffectStore& other);
+	EffectStore(EffectStore&& other) noexcept;
+	EffectStore& operator=(const EffectStore& other);
+	EffectStore& operator=(EffectStore&& other) noexcept;
+
+	iterator begin() { return iterator(this, -ptrdiff_t(frontInserts)); }
+	iterator end() { return iterator(); }
+	const_iterator begin() const { return const_iterator(this, -ptrdiff_t(frontInserts)); }
+	const_iterator end() const { return const_iterator(); }
+
+	bool empty() const { return live == 0; }
+	size_t size() const { return live; }
+	/** Number of effects the allocated chunks can hold */
+	size_t capacity() const { return chunks.size() * CHUNK_SIZE; }
+	Effect& front() { return *begin(); }
+
+	Effect& push_front(const Effect& fx);
+	Effect& push_back(const Effect& fx);
+	/** Erases the entry at it, leaving a gap until the next Compact() */
+	void erase(const iterator& it);
+	/** Erases all effects matching pred, then moves the rest together and frees
+	 * the chunks that aren't needed anymore. Returns whether any effect moved or was erased */
+	template<typename Pred>
+	bool Compact(Pred pred);
+	void clear();
+};
+
+template<typename Pred>
+bool EffectStore::Compact(Pred pred)
+{
+	bool changed = false;
+	size_t kept = 0;
+	for (size_t index = 0; index < used; ++index) {
+		if (!IsLive(index)) {
+			changed = true;
+			continue;
+		}
+		Effect* fx = Slot(index);
+		if (pred(*fx)) {
+			--live;
+			changed = true;
+			continue;
+		}
+		if (kept != index) {
+			*Slot(kept) = *fx;
+		}
+		++kept;
+	}
+	for (size_t index = 0; index < used; ++index) {
+		SetLive(index, index < kept);
+	}
+	used = kept;
+	frontInserts = 0;
+	Trim();
+	return changed;
+}
+
+}
+
+#endif // ! EFFECTSTORE_H
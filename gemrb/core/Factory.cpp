@@ -22,30 +22,102 @@
 
 namespace GemRB {
 
-void Factory::AddFactoryObject(object_t fobject)
+Factory::lru_t& Factory::ListOf(Place place)
 {
-	fobjects.push_back(std::move(fobject));
+	switch (place) {
+		case Place::InUse:
+			return inUse;
+		case Place::Pinned:
+			return pinned;
+		default:
+			return lru;
+	}
 }
 
-int Factory::IsLoaded(const ResRef& resref, SClass_ID type) const
+void Factory::AddFactoryObject(object_t fobject, bool pin)
 {
-	if (resref.IsEmpty()) {
-		return -1;
+	// like the old linear lookups, the first object loaded under a name wins
+	Key key { fobject->resRef, fobject->SuperClassID };
+	auto it = index.find(key);
+	if (it != index.end()) {
+		Entry& entry = *it->second;
+		if (pin && entry.place != Place::Pinned) {
+			pinned.splice(pinned.end(), ListOf(entry.place), it->second);
+			entry.place = Place::Pinned;
+		}
+		return;
 	}
 
-	for (unsigned int i = 0; i < fobjects.size(); i++) {
-		if (fobjects[i]->SuperClassID == type) {
-			if (fobjects[i]->resRef == resref) {
-				return i;
-			}
-		}
+	// make room first, so the new object is never the one dropped
+	size_t size = fobject->GetMemorySize();
+	if (retryCountdown) retryCountdown--;
+	Evict(size, retryCountdown == 0);
+
+	lru_t& list = pin ? pinned : lru;
+	list.push_back({ std::move(fobject), size, pin ? Place::Pinned : Place::LRU });
+	index.emplace(key, std::prev(list.end()));
+	stats.used += size;
+	stats.objects = index.size();
+}
+
+Factory::object_t Factory::GetFactoryObject(const ResRef& resRef, SClass_ID type)
+{
+	if (resRef.IsEmpty()) {
+		return nullptr;
+	}
+
+	auto it = index.find({ resRef, type });
+	if (it == index.end()) {
+		stats.misses++;
+		return nullptr;
 	}
-	return -1;
+
+	stats.hits++;
+	Entry& entry = *it->second;
+	if (entry.place != Place::Pinned) {
+		lru.splice(lru.end(), ListOf(entry.place), it->second);
+		entry.place = Place::LRU;
+	}
+	return entry.object;
 }
 
-Factory::object_t Factory::GetFactoryObject(int pos) const
+void Factory::SetBudget(size_t bytes)
 {
-	return fobjects[pos];
+	stats.budget = bytes;
+	Evict(0, true);
+}
+
+void Factory::Evict(size_t incoming, bool retryInUse)
+{
+	if (stats.used + incoming <= stats.budget) return;
+
+	if (retryInUse && !inUse.empty()) {
+		// some may have been released since, give them another chance before the newer ones
+		for (Entry& entry : inUse) {
+			entry.place = Place::LRU;
+		}
+		lru.splice(lru.begin(), inUse);
+	}
+
+	auto it = lru.begin();
+	while (stats.used + incoming > stats.budget && it != lru.end()) {
+		// still in use elsewhere, dropping it would only cause a second copy to be loaded
+		if (it->object.use_count() > 1) {
+			it->place = Place::InUse;
+			inUse.splice(inUse.end(), lru, it++);
+			continue;
+		}
+
+		stats.used -= it->size;
+		stats.evictions++;
+		index.erase({ it->object->resRef, it->object->SuperClassID });
+		it = lru.erase(it);
+	}
+	stats.objects = index.size();
+
+	if (retryInUse) {
+		retryCountdown = inUse.size();
+	}
 }
 
 }
@@ -25,24 +25,81 @@
 
 #include "FactoryObject.h"
 
+#include <list>
 #include <memory>
+#include <unordered_map>
 
 namespace GemRB {
 
+/* Keeps loaded factory objects around under a memory budget. Lookups are hashed by
+ * (resref, type) and the least recently used objects nobody else holds are dropped first. */
 class GEM_EXPORT Factory {
 public:
 	using object_t = std::shared_ptr<FactoryObject>;
 
-	Factory() noexcept = default;
+	static constexpr size_t DefaultBudget = 64 * 1024 * 1024;
+
+	struct Stats {
+		size_t objects = 0;
+		size_t used = 0;
+		size_t budget = 0;
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+	};
+
+	explicit Factory(size_t budget = DefaultBudget) noexcept
+	{
+		stats.budget = budget;
+	}
 	Factory(const Factory&) = delete;
 	Factory& operator=(const Factory&) = delete;
 
-	void AddFactoryObject(object_t fobject);
-	int IsLoaded(const ResRef& resRef, SClass_ID type) const;
-	object_t GetFactoryObject(int pos) const;
+	// pinned objects are never evicted, use it for those that can't be loaded again
+	void AddFactoryObject(object_t fobject, bool pin = false);
+	object_t GetFactoryObject(const ResRef& resRef, SClass_ID type);
+
+	void SetBudget(size_t bytes);
+	const Stats& GetStats() const { return stats; }
 
 private:
-	std::vector<object_t> fobjects;
+	struct Key {
+		ResRef resRef;
+		SClass_ID type;
+
+		bool operator==(const Key& other) const { return type == other.type && resRef == other.resRef; }
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const { return CstrHashCI()(key.resRef) ^ key.type; }
+	};
+
+	enum class Place : uint8_t {
+		LRU,
+		InUse,
+		Pinned
+	};
+
+	struct Entry {
+		object_t object;
+		size_t size;
+		Place place;
+	};
+
+	// only the lru list is scanned for eviction, front is the least recently used;
+	// objects found still held elsewhere wait in inUse until they are looked up again,
+	// pinned ones are never looked at. The held ones are only retried once per as many
+	// additions as there were of them, so adding stays amortized O(1)
+	using lru_t = std::list<Entry>;
+	lru_t lru;
+	lru_t inUse;
+	lru_t pinned;
+	std::unordered_map<Key, lru_t::iterator, KeyHash> index;
+	Stats stats;
+	size_t retryCountdown = 0;
+
+	lru_t& ListOf(Place place);
+	void Evict(size_t incoming, bool retryInUse);
 };
 
 }
@@ -36,6 +36,9 @@ public:
 	FactoryObject(const ResRef& name, SClass_ID superClassID)
 		: SuperClassID(superClassID), resRef(name) {};
 	virtual ~FactoryObject() noexcept = default;
+
+	// rough number of bytes held, used to budget the factory cache
+	virtual size_t GetMemorySize() const { return 0; }
 };
 
 }
@@ -85,6 +85,7 @@ struct Injured {
 Game::Game(void)
 	: Scriptable(ST_GLOBAL)
 {
+	InvalidateVariableHandles();
 	SetScript(core->GlobalScript, 0);
 	weather = new Particles(200);
 	weather->SetRegion(0, 0, core->config.Width, core->config.Height);
@@ -139,6 +140,7 @@ Game::Game(void)
 
 Game::~Game(void)
 {
+	InvalidateVariableHandles();
 	delete weather;
 	for (auto map : Maps) {
 		delete map;
@@ -855,33 +857,48 @@ void Game::PlacePersistents(Map* newMap, const ResRef& resRef)
 /* Loads an area */
 int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 {
-	auto sE = core->GetGUIScriptEngine();
-
 	int index = FindMap(resRef);
 	if (index >= 0) {
 		return index;
 	}
 
+	ResourceManager::PrefetchStats before = gamedata->GetPrefetchStats();
+	ResourceManager::LookupStats lookupsBefore = gamedata->GetLookupStats();
+	int ret = LoadNewMap(resRef, loadscreen);
+
+	// whether the area loaded or not, its prefetched resources are no use anymore
+	ResourceManager::PrefetchStats after = gamedata->GetPrefetchStats();
+	ResourceManager::LookupStats lookupsAfter = gamedata->GetLookupStats();
+	Log(DEBUG, "Game", "Prefetching for {}: {} hits, {} misses, {} still queued",
+	    resRef, after.hits - before.hits, after.misses - before.misses, after.queueDepth);
+	Log(DEBUG, "Game", "Resource lookups for {}: {} cached, {} searched",
+	    resRef, lookupsAfter.hits - lookupsBefore.hits, lookupsAfter.misses - lookupsBefore.misses);
+	gamedata->DiscardPrefetched();
+
+	core->LoadProgress(100);
+	return ret;
+}
+
+int Game::LoadNewMap(const ResRef& resRef, bool loadscreen)
+{
+	auto sE = core->GetGUIScriptEngine();
 	if (loadscreen && sE) {
 		sE->RunFunction("LoadScreen", "StartLoadScreen");
 		sE->RunFunction("LoadScreen", "SetLoadScreen");
 	}
 
 	if (core->saveGameAREExtractor.extractARE(resRef) != GEM_OK) {
-		core->LoadProgress(100);
 		return GEM_ERROR;
 	}
 
 	DataStream* ds = gamedata->GetResourceStream(resRef, IE_ARE_CLASS_ID);
 	auto mM = GetImporter<MapMgr>(IE_ARE_CLASS_ID, ds);
 	if (!mM) {
-		core->LoadProgress(100);
 		return GEM_ERROR;
 	}
 
 	Map* newMap = mM->GetMap(resRef, IsDay());
 	if (!newMap) {
-		core->LoadProgress(100);
 		return GEM_ERROR;
 	}
 
@@ -907,8 +924,7 @@ int Game::LoadMap(const ResRef& resRef, bool loadscreen)
 	}
 
 	core->GetAudioDrv()->SetReverbProperties(newMap->GetReverbProperties());
-
-	core->LoadProgress(100);
+	newMap->PrefetchSounds();
 	return ret;
 }
 
@@ -1605,8 +1621,18 @@ void Game::UpdateScripts()
 
 	PartyAttack = false;
 
+	// warn once per run of leaks, each one keeps the memory of the scope it was made in
+	static bool arenaLeaked = false;
 	for (size_t idx = 0; idx < Maps.size(); idx++) {
+		// triggers and actions rewind their own target lists, this catches whatever else the scripts built
+		TargetArena::Scope targetScope;
 		Maps[idx]->UpdateScripts();
+		if (targetScope.Rewind()) {
+			arenaLeaked = false;
+		} else if (!arenaLeaked) {
+			arenaLeaked = true;
+			Log(WARNING, "Game", "{} target lists outlived the scripts of {}, not rewinding their memory!", TargetArena::LiveTargets(), Maps[idx]->GetScriptName());
+		}
 	}
 
 	bool combatEnded = false;
@@ -521,6 +521,8 @@ private:
 	bool CastOnRest() const;
 	void PlayerDream() const;
 	void TextDream();
+	/** the part of LoadMap that reads an area not in the game yet */
+	int LoadNewMap(const ResRef& resRef, bool loadScreen);
 };
 
 }
@@ -330,8 +330,8 @@ Factory::object_t GameData::GetFactoryResource(const ResRef& resName, SClass_ID
 	if (resName.IsEmpty()) return nullptr;
 
 	// already cached?
-	int objectIndex = factory.IsLoaded(resName, type);
-	if (objectIndex != -1) return factory.GetFactoryObject(objectIndex);
+	auto cached = factory.GetFactoryObject(resName, type);
+	if (cached) return cached;
 
 	switch (type) {
 		case IE_BAM_CLASS_ID:
@@ -139,12 +139,15 @@ public:
 		return std::static_pointer_cast<T>(GetFactoryResource(resName, type, silent));
 	}
 
+	const Factory::Stats& GetFactoryStats() const { return factory.GetStats(); }
+
 	template<typename T, typename... ARGS>
 	std::shared_ptr<T> AddFactoryResource(ARGS&&... args)
 	{
 		static_assert(std::is_base_of<FactoryObject, T>::value, "T must be a FactoryObject.");
 		auto obj = std::make_shared<T>(std::forward<ARGS>(args)...);
-		factory.AddFactoryObject(obj);
+		// there is nothing to load it again from, so it has to stay
+		factory.AddFactoryObject(obj, true);
 		return obj;
 	}
 
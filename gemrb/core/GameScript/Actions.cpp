@@ -123,7 +123,7 @@ void GameScript::SG(Scriptable* Sender, Action* parameters)
 
 void GameScript::SetGlobal(Scriptable* Sender, Action* parameters)
 {
-	SetVariable(Sender, parameters->string0Parameter, parameters->int0Parameter);
+	SetVariable(Sender, parameters->Variable0(), parameters->int0Parameter);
 }
 
 void GameScript::SetGlobalRandom(Scriptable* Sender, Action* parameters)
@@ -3428,9 +3428,9 @@ void GameScript::GlobalAddGlobal(Scriptable* Sender, Action* parameters)
 /* adding the number to the global, they could be area or locals */
 void GameScript::IncrementGlobal(Scriptable* Sender, Action* parameters)
 {
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter);
-	SetVariable(Sender, parameters->string0Parameter,
-		    value + parameters->int0Parameter);
+	VariableHandle& variable = parameters->Variable0();
+	ieDword value = CheckVariable(Sender, variable);
+	SetVariable(Sender, variable, value + parameters->int0Parameter);
 }
 
 // adding the number to the global ONLY if the first global is zero
@@ -1760,20 +1760,17 @@ Action* ParamCopyNoOverride(const Action* parameters)
 	return newAction;
 }
 
-void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value, VarContext context)
-{
-	ieVariable key { VarName };
+// bumped whenever a game is created or destroyed, so cached game-wide slots can't dangle
+static unsigned int variableGeneration = 1;
 
-	auto SetLocalVariable = [=](ieVarsMap& vars, const ieVariable& key, ieDword value) {
-		auto lookup = vars.find(key);
-
-		if (lookup != vars.cend()) {
-			lookup->second = value;
-		} else if (!NoCreate) {
-			vars[key] = value;
-		}
-	};
+void InvalidateVariableHandles()
+{
+	variableGeneration++;
+}
 
+void ResolveVariable(VariableHandle& handle, const StringParam& VarName, VarContext context)
+{
+	handle.key = ieVariable { VarName };
 	if (context.IsEmpty()) {
 		const char* varName = &VarName[6];
 		//some HoW triggers use a : to separate the scope from the variable name
@@ -1781,94 +1778,166 @@ void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value,
 			varName++;
 		}
 		context.Format("{:.6}", VarName);
-		key = ieVariable { varName };
+		handle.key = ieVariable { varName };
 	}
-	ScriptDebugLog(DebugMode::VARIABLES, "Setting variable(\"{}{}\", {})", context, VarName, value);
 
+	handle.slot = nullptr;
+	handle.generation = 0;
+	handle.area.Reset();
 	if (context == "MYAREA") {
-		SetLocalVariable(Sender->GetCurrentArea()->locals, key, value);
-		return;
+		handle.scope = VariableHandle::Scope::MyArea;
+	} else if (context == "LOCALS") {
+		handle.scope = VariableHandle::Scope::Locals;
+	} else if (HasKaputz && context == "KAPUTZ") {
+		handle.scope = VariableHandle::Scope::Kaputz;
+	} else if (context == "GLOBAL") {
+		handle.scope = VariableHandle::Scope::Global;
+	} else {
+		// map name context, eg. AR1324
+		handle.scope = VariableHandle::Scope::Area;
+		handle.area = context;
 	}
-	if (context == "LOCALS") {
-		SetLocalVariable(Sender->locals, key, value);
-		return;
+}
+
+static StringView VariableScopeName(const VariableHandle& handle)
+{
+	switch (handle.scope) {
+		case VariableHandle::Scope::Global:
+			return "GLOBAL";
+		case VariableHandle::Scope::Kaputz:
+			return "KAPUTZ";
+		case VariableHandle::Scope::Locals:
+			return "LOCALS";
+		case VariableHandle::Scope::MyArea:
+			return "MYAREA";
+		case VariableHandle::Scope::Area:
+			return StringView(handle.area);
+		default:
+			return "";
 	}
-	Game* game = core->GetGame();
-	if (HasKaputz && context == "KAPUTZ") {
-		SetLocalVariable(game->kaputz, key, value);
-		return;
+}
+
+// the game-wide variables are never erased, so their slots stay put for the whole game
+static ieDword* GameVariableSlot(VariableHandle& handle, bool create)
+{
+	if (handle.slot && handle.generation == variableGeneration) {
+		return handle.slot;
 	}
-	if (context == "GLOBAL") {
-		SetLocalVariable(game->locals, key, value);
-	} else {
-		// map name context, eg. AR1324
-		Map* map = game->GetMap(game->FindMap(context));
-		if (map) {
-			SetLocalVariable(map->locals, key, value);
-		} else if (InDebugMode(DebugMode::VARIABLES)) {
-			Log(WARNING, "GameScript", "Invalid variable {} {} in SetVariable", context, VarName);
-		}
+
+	Game* game = core->GetGame();
+	ieVarsMap& vars = handle.scope == VariableHandle::Scope::Kaputz ? game->kaputz : game->locals;
+	auto lookup = vars.find(handle.key);
+	if (lookup == vars.end()) {
+		if (!create) {
+			return nullptr;
+		}
+		lookup = vars.emplace(handle.key, 0).first;
+	}
+
+	handle.slot = &lookup->second;
+	handle.generation = variableGeneration;
+	return handle.slot;
+}
+
+// the scriptable and area variables depend on the sender, so they are looked up each time
+template<typename SCRIPTABLE>
+static auto SenderVariables(const VariableHandle& handle, SCRIPTABLE* Sender) -> decltype(&Sender->locals)
+{
+	switch (handle.scope) {
+		case VariableHandle::Scope::Locals:
+			return &Sender->locals;
+		case VariableHandle::Scope::MyArea:
+			return &Sender->GetCurrentArea()->locals;
+		case VariableHandle::Scope::Area:
+			{
+				const Game* game = core->GetGame();
+				Map* map = game->GetMap(game->FindMap(handle.area));
+				return map ? &map->locals : nullptr;
+			}
+		default:
+			return nullptr;
 	}
 }
 
-void SetPointVariable(Scriptable* Sender, const StringParam& VarName, const Point& p, const VarContext& Context)
+static bool IsGameScope(const VariableHandle& handle)
 {
-	SetVariable(Sender, VarName, ((p.y & 0xFFFF) << 16) | (p.x & 0xFFFF), Context);
+	return handle.scope == VariableHandle::Scope::Global || handle.scope == VariableHandle::Scope::Kaputz;
 }
 
-ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VarContext context, bool* valid)
+void SetVariable(Scriptable* Sender, VariableHandle& handle, ieDword value)
 {
-	ieVariable key { VarName };
+	ScriptDebugLog(DebugMode::VARIABLES, "Setting variable(\"{}{}\", {})", VariableScopeName(handle), handle.key, value);
 
-	auto GetLocalVariable = [](const ieVarsMap& vars, VarContext context, const ieVariable& key) -> ieDword {
-		auto lookup = vars.find(key);
-		if (lookup != vars.cend()) {
-			ScriptDebugLog(DebugMode::VARIABLES, "CheckVariable {}{}: {}", context, key, lookup->second);
-			return lookup->second;
+	if (IsGameScope(handle)) {
+		ieDword* slot = GameVariableSlot(handle, !NoCreate);
+		if (slot) {
+			*slot = value;
 		}
+		return;
+	}
 
-		return 0;
-	};
-
-	if (context.IsEmpty()) {
-		const char* varName = &VarName[6];
-		//some HoW triggers use a : to separate the scope from the variable name
-		if (*varName == ':') {
-			varName++;
+	ieVarsMap* vars = SenderVariables(handle, Sender);
+	if (!vars) {
+		if (InDebugMode(DebugMode::VARIABLES)) {
+			Log(WARNING, "GameScript", "Invalid variable {} {} in SetVariable", VariableScopeName(handle), handle.key);
 		}
-		context.Format("{:.6}", VarName);
-		key = ieVariable { varName };
+		return;
 	}
 
-	if (context == "MYAREA") {
-		return GetLocalVariable(Sender->GetCurrentArea()->locals, context, key);
+	auto lookup = vars->find(handle.key);
+	if (lookup != vars->cend()) {
+		lookup->second = value;
+	} else if (!NoCreate) {
+		(*vars)[handle.key] = value;
 	}
+}
 
-	if (context == "LOCALS") {
-		return GetLocalVariable(Sender->locals, context, key);
+void SetVariable(Scriptable* Sender, const StringParam& VarName, ieDword value, VarContext context)
+{
+	VariableHandle handle;
+	ResolveVariable(handle, VarName, context);
+	SetVariable(Sender, handle, value);
+}
+
+void SetPointVariable(Scriptable* Sender, const StringParam& VarName, const Point& p, const VarContext& Context)
+{
+	SetVariable(Sender, VarName, ((p.y & 0xFFFF) << 16) | (p.x & 0xFFFF), Context);
+}
+
+ieDword CheckVariable(const Scriptable* Sender, VariableHandle& handle, bool* valid)
+{
+	if (IsGameScope(handle)) {
+		const ieDword* slot = GameVariableSlot(handle, false);
+		if (!slot) {
+			return 0;
+		}
+		ScriptDebugLog(DebugMode::VARIABLES, "CheckVariable {}{}: {}", VariableScopeName(handle), handle.key, *slot);
+		return *slot;
 	}
 
-	const Game* game = core->GetGame();
-	if (HasKaputz && context == "KAPUTZ") {
-		return GetLocalVariable(game->kaputz, context, key);
+	const ieVarsMap* vars = SenderVariables(handle, Sender);
+	if (!vars) {
+		if (valid) *valid = false;
+		ScriptDebugLog(DebugMode::VARIABLES, "Invalid variable {} {} in checkvariable", VariableScopeName(handle), handle.key);
+		return 0;
 	}
 
-	if (context == "GLOBAL") {
-		return GetLocalVariable(game->locals, context, key);
-	} else {
-		// map name context, eg. AR1324
-		const Map* map = game->GetMap(game->FindMap(context));
-		if (map) {
-			return GetLocalVariable(map->locals, context, key);
-		} else {
-			if (valid) *valid = false;
-			ScriptDebugLog(DebugMode::VARIABLES, "Invalid variable {} {} in checkvariable", context, VarName);
-		}
+	auto lookup = vars->find(handle.key);
+	if (lookup != vars->cend()) {
+		ScriptDebugLog(DebugMode::VARIABLES, "CheckVariable {}{}: {}", VariableScopeName(handle), handle.key, lookup->second);
+		return lookup->second;
 	}
 
 	return 0;
 }
 
+ieDword CheckVariable(const Scriptable* Sender, const StringParam& VarName, VarContext context, bool* valid)
+{
+	VariableHandle handle;
+	ResolveVariable(handle, VarName, context);
+	return CheckVariable(Sender, handle, valid);
+}
+
 Point CheckPointVariable(const Scriptable* Sender, const StringParam& VarName, const VarContext& Context, bool* valid)
 {
 	ieDword val = CheckVariable(Sender, VarName, Context, valid);
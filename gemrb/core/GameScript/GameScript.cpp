@@ -1844,9 +1844,38 @@ Script* GameScript::CacheScript(const ResRef& resRef, bool AIScript)
 		stream->ReadLine(line, 10);
 	}
 	delete stream;
+	newScript->Compile();
 	return newScript;
 }
 
+static bool UsesVariableHandle(TriggerFunction func)
+{
+	return func == GameScript::Global || func == GameScript::GlobalLT || func == GameScript::GlobalGT;
+}
+
+static bool UsesVariableHandle(ActionFunction func)
+{
+	return func == GameScript::SetGlobal || func == GameScript::IncrementGlobal;
+}
+
+void Script::Compile() const
+{
+	for (const ResponseBlock* rB : responseBlocks) {
+		if (rB->condition) {
+			rB->condition->Compile();
+		}
+		if (!rB->responseSet) continue;
+
+		for (const Response* rE : rB->responseSet->responses) {
+			for (const Action* aC : rE->actions) {
+				if (aC && aC->actionID < MAX_ACTIONS && UsesVariableHandle(actions[aC->actionID])) {
+					aC->Variable0();
+				}
+			}
+		}
+	}
+}
+
 /*
  * if you pass non-NULL parameters, continuing is set to whether we Continue()ed
  * (should start false and be passed to next script's Update),
@@ -2019,6 +2048,15 @@ int GameScript::EvaluateString(Scriptable* Sender, const char* String)
 	return 0;
 }
 
+static StringView TriggerName(unsigned short triggerID)
+{
+	StringView name = triggersTable->GetValue(triggerID);
+	if (name.empty()) {
+		name = triggersTable->GetValue(triggerID | 0x4000);
+	}
+	return name;
+}
+
 bool Condition::Evaluate(Scriptable* Sender) const
 {
 	int ORcount = 0;
@@ -2029,11 +2067,15 @@ bool Condition::Evaluate(Scriptable* Sender) const
 		return true;
 	}
 
-	for (const Trigger* tR : triggers) {
-		//do not evaluate triggers in an Or() block if one of them
-		//was already True() ... but this sane approach was only used in iwd2!
-		if (!core->HasFeature(GFFlags::EFFICIENT_OR) || !ORcount || !subresult) {
-			result = tR->Evaluate(Sender);
+	// the target lists built by the triggers die with them
+	TargetArena::Scope targetScope;
+
+	//do not evaluate triggers in an Or() block if one of them
+	//was already True() ... but this sane approach was only used in iwd2!
+	bool efficientOr = core->HasFeature(GFFlags::EFFICIENT_OR);
+	for (size_t idx = 0; idx < triggers.size(); ++idx) {
+		if (!efficientOr || !ORcount || !subresult) {
+			result = EvaluateTrigger(idx, Sender);
 		}
 		if (result > 1) {
 			//we started an Or() block
@@ -2065,6 +2107,39 @@ bool Condition::Evaluate(Scriptable* Sender) const
 	return true;
 }
 
+void Condition::Compile()
+{
+	compiled.clear();
+	compiled.reserve(triggers.size());
+	for (const Trigger* tR : triggers) {
+		CompiledTrigger entry;
+		entry.trigger = tR;
+		entry.negate = tR->flags & TF_NEGATE;
+		// corrupted and unhandled codes stay on the slow path, so they still get reported
+		if (tR->triggerID < MAX_TRIGGERS) {
+			entry.func = GemRB::triggers[tR->triggerID];
+			entry.name = TriggerName(tR->triggerID);
+			if (UsesVariableHandle(entry.func)) {
+				tR->Variable0();
+			}
+		}
+		compiled.push_back(entry);
+	}
+}
+
+int Condition::EvaluateTrigger(size_t idx, Scriptable* Sender) const
+{
+	if (compiled.size() != triggers.size() || !compiled[idx].func) {
+		return triggers[idx]->Evaluate(Sender);
+	}
+
+	const CompiledTrigger& entry = compiled[idx];
+	ScriptDebugLog(DebugMode::TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", entry.trigger->triggerID, entry.name, Sender->GetScriptName(), fmt::WideToChar { Sender->GetName() });
+
+	int ret = entry.func(Sender, entry.trigger);
+	return entry.negate ? !ret : ret;
+}
+
 /* this may return more than a boolean, in case of Or(x) */
 int Trigger::Evaluate(Scriptable* Sender) const
 {
@@ -2073,17 +2148,13 @@ int Trigger::Evaluate(Scriptable* Sender) const
 		return 0;
 	}
 	TriggerFunction func = triggers[triggerID];
-	StringView tmpstr = triggersTable->GetValue(triggerID);
-	if (tmpstr.empty()) {
-		tmpstr = triggersTable->GetValue(triggerID | 0x4000);
-	}
 	if (!func) {
 		triggers[triggerID] = GameScript::False;
 		Log(WARNING, "GameScript", "Unhandled trigger code: {:#x} {}",
-		    triggerID, tmpstr);
+		    triggerID, TriggerName(triggerID));
 		return 0;
 	}
-	ScriptDebugLog(DebugMode::TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, tmpstr, Sender->GetScriptName(), fmt::WideToChar { Sender->GetName() });
+	ScriptDebugLog(DebugMode::TRIGGERS, "Executing trigger code: {:#x} {} (Sender: {} / {})", triggerID, TriggerName(triggerID), Sender->GetScriptName(), fmt::WideToChar { Sender->GetName() });
 
 	int ret = func(Sender, this);
 	if (flags & TF_NEGATE) {
@@ -2236,6 +2307,7 @@ static bool CheckDeadException(const Scriptable* sender, int actionID)
 void GameScript::ExecuteAction(Scriptable* Sender, Action* aC)
 {
 	int actionID = aC->actionID;
+	TargetArena::Scope targetScope;
 
 	// reallow area scripts after us, if they were disabled
 	if (aC->flags & ACF_REALLOW_SCRIPTS) {
@@ -2366,6 +2438,14 @@ bool Object::isNull() const
 	return true;
 }
 
+VariableHandle& Trigger::Variable0() const
+{
+	if (variable0Handle.scope == VariableHandle::Scope::Unresolved) {
+		ResolveVariable(variable0Handle, string0Parameter);
+	}
+	return variable0Handle;
+}
+
 std::string Trigger::dump() const
 {
 	AssertCanary(__func__);
@@ -2385,6 +2465,14 @@ std::string Trigger::dump() const
 	return buffer;
 }
 
+VariableHandle& Action::Variable0() const
+{
+	if (variable0Handle.scope == VariableHandle::Scope::Unresolved) {
+		ResolveVariable(variable0Handle, string0Parameter);
+	}
+	return variable0Handle;
+}
+
 std::string Action::dump() const
 {
 	AssertCanary(__func__);
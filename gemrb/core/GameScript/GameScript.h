@@ -157,6 +157,25 @@ public:
 	bool isNull() const;
 };
 
+// a scoped variable reference like "GLOBALfoo" or "AR1000bar", split and resolved
+// only once; game-wide slots are also cached until the game changes
+struct VariableHandle {
+	enum class Scope : uint8_t {
+		Unresolved,
+		Global,
+		Kaputz,
+		Locals,
+		MyArea,
+		Area
+	};
+
+	Scope scope = Scope::Unresolved;
+	ieVariable key;
+	ResRef area; // only for Scope::Area
+	ieDword* slot = nullptr; // only for Scope::Global and Scope::Kaputz
+	unsigned int generation = 0;
+};
+
 class GEM_EXPORT Trigger final : protected Canary {
 public:
 	Trigger() noexcept
@@ -190,14 +209,21 @@ public:
 		ResRef resref1Parameter;
 	};
 
+	// string0Parameter as a scoped variable, resolved by Condition::Compile or on first use
+	VariableHandle& Variable0() const;
 	std::string dump() const;
 
 	void Release()
 	{
 		delete this;
 	}
+
+private:
+	mutable VariableHandle variable0Handle;
 };
 
+using TriggerFunction = int (*)(Scriptable*, const Trigger*);
+
 class GEM_EXPORT Condition final : protected Canary {
 public:
 	~Condition() noexcept override
@@ -214,8 +240,22 @@ public:
 		delete this;
 	}
 	bool Evaluate(Scriptable* Sender) const;
+	// resolve the trigger handlers (and their names for debug output) up front
+	void Compile();
 
 	std::vector<Trigger*> triggers;
+
+private:
+	struct CompiledTrigger {
+		TriggerFunction func = nullptr;
+		const Trigger* trigger = nullptr;
+		StringView name;
+		bool negate = false;
+	};
+	// parallel to triggers, only filled for scripts in the BCS cache
+	std::vector<CompiledTrigger> compiled;
+
+	int EvaluateTrigger(size_t idx, Scriptable* Sender) const;
 };
 
 class GEM_EXPORT Action final : protected Canary {
@@ -263,6 +303,7 @@ public:
 
 private:
 	int RefCount = 0;
+	mutable VariableHandle variable0Handle;
 
 public:
 	int GetRef() const
@@ -270,6 +311,8 @@ public:
 		return RefCount;
 	}
 
+	// string0Parameter as a scoped variable, resolved by Script::Compile or on first use
+	VariableHandle& Variable0() const;
 	std::string dump() const;
 
 	void Release()
@@ -375,13 +418,14 @@ public:
 
 	std::vector<ResponseBlock*> responseBlocks;
 
+	void Compile() const;
+
 	void Release()
 	{
 		delete this;
 	}
 };
 
-using TriggerFunction = int (*)(Scriptable*, const Trigger*);
 using ActionFunction = void (*)(Scriptable*, Action*);
 using ObjectFunction = Targets* (*) (const Scriptable*, Targets*, int ga_flags);
 using IDSFunction = int (*)(const Actor*, int parameter);
@@ -521,6 +565,9 @@ private: //Internal Functions
 	int scriptlevel;
 
 public: //Script Functions
+	// the stat value tests behind ID_Alignment and ID_Allegiance
+	static bool MatchAlignment(int value, int parameter);
+	static bool MatchAllegiance(int value, int parameter);
 	static int ID_Alignment(const Actor* actor, int parameter);
 	static int ID_Allegiance(const Actor* actor, int parameter);
 	static int ID_AVClass(const Actor* actor, int parameter);
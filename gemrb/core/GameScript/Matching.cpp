@@ -33,6 +33,8 @@
 #include "Scriptable/Door.h"
 #include "Scriptable/InfoPoint.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 /* return a Targets object with a single scriptable inside */
@@ -66,6 +68,67 @@ static inline bool DoObjectIDSCheck(const Object* oC, const Actor* ac, bool* fil
 	return true;
 }
 
+/* appends the actor indices of the buckets with a stat value passing matches */
+template<typename PREDICATE>
+static void CollectBuckets(const ActorStatIndex::Buckets& buckets, PREDICATE&& matches, std::vector<size_t>& found)
+{
+	for (const auto& bucket : buckets) {
+		if (!matches(static_cast<int>(bucket.first))) continue;
+		found.insert(found.end(), bucket.second.cbegin(), bucket.second.cend());
+	}
+}
+
+/* narrow down IDS targeting with the map's stat index: collects the indices
+ * of actors that can pass the most selective indexed field of oC, in the
+ * order of the actor list; returns false if no field was indexed */
+static bool GetIDSCandidates(const Map* map, const Object* oC, std::vector<size_t>& candidates)
+{
+	const ActorStatIndex& index = map->GetStatIndex();
+	bool narrowed = false;
+	std::vector<size_t> fieldCandidates;
+	for (int j = 0; j < ObjectIDSCount; j++) {
+		int parameter = oC->objectFields[j];
+		if (!parameter) continue;
+
+		IDSFunction func = idtargets[j];
+		fieldCandidates.clear();
+		if (func == GameScript::ID_Allegiance) {
+			const auto& buckets = index.GetBuckets(ActorStatIndex::StatSlot(IE_EA));
+			CollectBuckets(buckets, [parameter](int value) { return GameScript::MatchAllegiance(value, parameter); }, fieldCandidates);
+		} else if (func == GameScript::ID_Alignment) {
+			const auto& buckets = index.GetBuckets(ActorStatIndex::StatSlot(IE_ALIGNMENT));
+			CollectBuckets(buckets, [parameter](int value) { return GameScript::MatchAlignment(value, parameter); }, fieldCandidates);
+		} else {
+			int slot = -1;
+			if (func == GameScript::ID_General) {
+				slot = ActorStatIndex::StatSlot(IE_GENERAL);
+			} else if (func == GameScript::ID_Race) {
+				slot = ActorStatIndex::StatSlot(IE_RACE);
+			} else if (func == GameScript::ID_Specific) {
+				slot = ActorStatIndex::StatSlot(IE_SPECIFIC);
+			} else if (func == GameScript::ID_Gender) {
+				slot = ActorStatIndex::StatSlot(IE_SEX);
+			}
+			if (slot == -1) continue;
+
+			// a plain comparison, so a single bucket can match
+			const auto& buckets = index.GetBuckets(slot);
+			auto bucket = buckets.find(static_cast<ieDword>(parameter));
+			if (bucket != buckets.cend()) {
+				fieldCandidates = bucket->second;
+			}
+		}
+
+		if (!narrowed || fieldCandidates.size() < candidates.size()) {
+			candidates.swap(fieldCandidates);
+			narrowed = true;
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	return narrowed;
+}
+
 /* do object filtering: Myself, LastAttackerOf(Player1), etc */
 static inline Targets* DoObjectFiltering(const Scriptable* Sender, Targets* tgts, const Object* oC, int ga_flags)
 {
@@ -199,10 +262,12 @@ static Targets* EvaluateObject(const Map* map, const Scriptable* Sender, const O
 	Targets* tgts = NULL;
 
 	//we need to get a subset of actors from the large array
-	//if this gets slow, we will need some index tables
-	int i = map->GetActorCount(true);
+	//so start from the ones the stat index says could match
+	std::vector<size_t> candidates;
+	bool narrowed = GetIDSCandidates(map, oC, candidates);
+	size_t i = narrowed ? candidates.size() : map->GetActorCount(true);
 	while (i--) {
-		Actor* ac = map->GetActor(i, true);
+		Actor* ac = map->GetActor(static_cast<int>(narrowed ? candidates[i] : i), true);
 		if (!ac) continue; // is this check really needed?
 		// don't return Sender in IDS targeting!
 		// unless it's pst, which relies on it in 3012cut2-3012cut7.bcs
@@ -24,16 +24,154 @@
 #include "GameScript/GSUtils.h"
 #include "Strings/StringConversion.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
 namespace GemRB {
 
+namespace {
+
+struct Arena {
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+	static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+	// chunks are kept around, so after the first few ticks we stop allocating
+	std::vector<std::unique_ptr<char[]>> chunks;
+	std::vector<std::unique_ptr<char[]>> oversized;
+	size_t chunk = 0;
+	size_t offset = 0;
+	size_t liveTargets = 0;
+};
+
+Arena& GetArena()
+{
+	static Arena arena;
+	return arena;
+}
+
+}
+
+static size_t Align(size_t size)
+{
+	return (size + Arena::ALIGNMENT - 1) & ~(Arena::ALIGNMENT - 1);
+}
+
+void* TargetArena::Allocate(size_t size)
+{
+	Arena& arena = GetArena();
+	size = Align(size);
+	if (size > Arena::CHUNK_SIZE) {
+		arena.oversized.emplace_back(new char[size]);
+		return arena.oversized.back().get();
+	}
+
+	if (arena.chunks.empty() || arena.offset + size > Arena::CHUNK_SIZE) {
+		if (!arena.chunks.empty()) {
+			++arena.chunk;
+		}
+		if (arena.chunk == arena.chunks.size()) {
+			arena.chunks.emplace_back(new char[Arena::CHUNK_SIZE]);
+		}
+		arena.offset = 0;
+	}
+	void* ptr = arena.chunks[arena.chunk].get() + arena.offset;
+	arena.offset += size;
+	return ptr;
+}
+
+void TargetArena::Deallocate(void* ptr, size_t size) noexcept
+{
+	Arena& arena = GetArena();
+	size = Align(size);
+	if (arena.chunks.empty() || size > Arena::CHUNK_SIZE || arena.offset < size) return;
+
+	// a list or Targets freed right after it was made, the usual case for a single trigger check
+	if (static_cast<char*>(ptr) == arena.chunks[arena.chunk].get() + arena.offset - size) {
+		arena.offset -= size;
+	}
+}
+
+TargetArena::Scope::Scope() noexcept
+{
+	const Arena& arena = GetArena();
+	chunk = arena.chunk;
+	offset = arena.offset;
+	oversized = arena.oversized.size();
+	liveTargets = arena.liveTargets;
+}
+
+TargetArena::Scope::~Scope() noexcept
+{
+	Rewind();
+}
+
+bool TargetArena::Scope::Rewind() noexcept
+{
+	if (rewound) return true;
+
+	Arena& arena = GetArena();
+	if (arena.liveTargets > liveTargets) return false;
+
+	arena.chunk = chunk;
+	arena.offset = offset;
+	arena.oversized.resize(oversized);
+	rewound = true;
+	return true;
+}
+
+size_t TargetArena::LiveTargets()
+{
+	return GetArena().liveTargets;
+}
+
+Targets::Targets() noexcept
+{
+	++GetArena().liveTargets;
+}
+
+Targets::Targets(const Targets& other) noexcept
+	: objects(other.objects), removed(other.removed)
+{
+	++GetArena().liveTargets;
+}
+
+Targets::~Targets() noexcept
+{
+	--GetArena().liveTargets;
+}
+
+void* Targets::operator new(size_t size)
+{
+	return TargetArena::Allocate(size);
+}
+
+static bool IsOfType(const targettype& tt, ScriptableType type)
+{
+	return tt.actor && (type == ST_ANY || tt.actor->Type == type);
+}
+
 size_t Targets::Count() const
 {
-	return objects.size();
+	return objects.size() - removed;
+}
+
+void Targets::Pop()
+{
+	targetlist::iterator m;
+	if (GetFirstTarget(m, ST_ANY)) {
+		RemoveTargetAt(m);
+	}
 }
 
 targettype* Targets::RemoveTargetAt(targetlist::iterator& m)
 {
-	m = objects.erase(m);
+	m->actor = nullptr;
+	++removed;
+	++m;
+	while (m != objects.end() && !m->actor) {
+		++m;
+	}
 	if (m != objects.end()) {
 		return &(*m);
 	}
@@ -42,9 +180,8 @@ targettype* Targets::RemoveTargetAt(targetlist::iterator& m)
 
 const targettype* Targets::GetLastTarget(ScriptableType type)
 {
-	targetlist::const_iterator m = objects.end();
-	while (m-- != objects.begin()) {
-		if (type == ST_ANY || (*m).actor->Type == type) {
+	for (auto m = objects.rbegin(); m != objects.rend(); ++m) {
+		if (IsOfType(*m, type)) {
 			return &(*m);
 		}
 	}
@@ -55,7 +192,7 @@ const targettype* Targets::GetFirstTarget(targetlist::iterator& m, ScriptableTyp
 {
 	m = objects.begin();
 	while (m != objects.end()) {
-		if (type != ST_ANY && (*m).actor->Type != type) {
+		if (!IsOfType(*m, type)) {
 			m++;
 			continue;
 		}
@@ -68,7 +205,7 @@ const targettype* Targets::GetNextTarget(targetlist::iterator& m, ScriptableType
 {
 	m++;
 	while (m != objects.end()) {
-		if (type != ST_ANY && (*m).actor->Type != type) {
+		if (!IsOfType(*m, type)) {
 			m++;
 			continue;
 		}
@@ -81,7 +218,7 @@ Scriptable* Targets::GetTarget(unsigned int index, ScriptableType type)
 {
 	targetlist::iterator m = objects.begin();
 	while (m != objects.end()) {
-		if (type == ST_ANY || (*m).actor->Type == type) {
+		if (IsOfType(*m, type)) {
 			if (!index) {
 				return (*m).actor;
 			}
@@ -115,25 +252,26 @@ void Targets::AddTarget(Scriptable* target, unsigned int distance, int flags)
 	}
 
 	targettype newTarget = { target, distance };
-	for (auto m = objects.begin(); m != objects.end(); ++m) {
-		if ((*m).distance > distance) {
-			objects.insert(m, newTarget);
-			return;
-		}
+	auto later = [](unsigned int dist, const targettype& tt) {
+		return tt.distance > dist;
+	};
+	if (objects.empty()) {
+		objects.reserve(8);
 	}
-	objects.push_back(newTarget);
+	objects.insert(std::upper_bound(objects.begin(), objects.end(), distance, later), newTarget);
 }
 
 void Targets::Clear()
 {
 	objects.clear();
+	removed = 0;
 }
 
 void Targets::dump() const
 {
 	Log(DEBUG, "GameScript", "Target dump (actors only):");
 	for (const auto& object : objects) {
-		if (object.actor->Type == ST_ACTOR) {
+		if (IsOfType(object, ST_ACTOR)) {
 			Log(DEBUG, "GameScript", "{}", fmt::WideToChar { object.actor->GetName() });
 		}
 	}
@@ -144,13 +282,11 @@ void Targets::FilterObjectRect(const Object* oC)
 	// can't match anything if the second pair of coordinates (or all of them) are unset
 	if (oC->objectRect.w <= 0 || oC->objectRect.h <= 0) return;
 
-	for (auto m = objects.begin(); m != objects.end();) {
-		if (!IsInObjectRect((*m).actor->Pos, oC->objectRect)) {
-			m = objects.erase(m);
-		} else {
-			++m;
-		}
-	}
+	auto outside = [oC](const targettype& tt) {
+		return !tt.actor || !IsInObjectRect(tt.actor->Pos, oC->objectRect);
+	};
+	objects.erase(std::remove_if(objects.begin(), objects.end(), outside), objects.end());
+	removed = 0;
 }
 
 }
@@ -25,6 +25,8 @@
 
 #include "Scriptable/Scriptable.h"
 
+#include <vector>
+
 namespace GemRB {
 
 class Object;
@@ -34,16 +36,73 @@ struct targettype {
 	unsigned int distance;
 };
 
-using targetlist = std::list<targettype>;
+// Backing store for target lists, which only live while a trigger, action or
+// effect looks at them: a bump allocator that is rewound when the evaluation
+// that built them ends, so the many short lists built every tick avoid the heap.
+class GEM_EXPORT TargetArena {
+public:
+	// marks the arena on creation and rewinds to the mark when it ends, unless
+	// Targets made inside it are still alive; those only pin this scope's memory.
+	// Lists made before the scope must not grow inside it.
+	class GEM_EXPORT Scope {
+		size_t chunk;
+		size_t offset;
+		size_t oversized;
+		size_t liveTargets;
+		bool rewound = false;
+
+	public:
+		Scope() noexcept;
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+		~Scope() noexcept;
+
+		// returns false if something made inside the scope leaked
+		bool Rewind() noexcept;
+	};
+
+	static void* Allocate(size_t size);
+	// gives the memory back right away if it was the last allocation, otherwise when its scope ends
+	static void Deallocate(void* ptr, size_t size) noexcept;
+	static size_t LiveTargets();
+};
+
+template<typename T>
+struct TargetAllocator {
+	using value_type = T;
 
+	TargetAllocator() noexcept = default;
+	template<typename U>
+	TargetAllocator(const TargetAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n) { return static_cast<T*>(TargetArena::Allocate(n * sizeof(T))); }
+	void deallocate(T* ptr, size_t n) noexcept { TargetArena::Deallocate(ptr, n * sizeof(T)); }
+
+	template<typename U>
+	bool operator==(const TargetAllocator<U>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const TargetAllocator<U>&) const noexcept { return false; }
+};
+
+using targetlist = std::vector<targettype, TargetAllocator<targettype>>;
+
+// removed entries are only cleared (actor set to nullptr) and skipped, so
+// filtering a list while walking it doesn't shift the rest every time
 class GEM_EXPORT Targets {
 	targetlist objects;
+	size_t removed = 0;
 
 public:
-	Targets() noexcept {};
+	Targets() noexcept;
+	Targets(const Targets&) noexcept;
+	Targets& operator=(const Targets&) = default;
+	~Targets() noexcept;
+
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size) noexcept { TargetArena::Deallocate(ptr, size); }
 
 	size_t Count() const;
-	void Pop() { objects.pop_front(); };
+	void Pop();
 	targettype* RemoveTargetAt(targetlist::iterator& m);
 	const targettype* GetNextTarget(targetlist::iterator& m, ScriptableType type);
 	const targettype* GetLastTarget(ScriptableType type);
@@ -689,7 +689,7 @@ int GameScript::Global(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->Variable0(), &valid);
 	if (valid && value == parameters->int0Parameter) {
 		return 1;
 	}
@@ -706,7 +706,7 @@ int GameScript::GlobalLT(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->Variable0(), &valid);
 	if (valid && value < parameters->int0Parameter) return 1;
 	return 0;
 }
@@ -721,7 +721,7 @@ int GameScript::GlobalGT(Scriptable* Sender, const Trigger* parameters)
 {
 	bool valid = true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, {}, &valid);
+	ieDwordSigned value = CheckVariable(Sender, parameters->Variable0(), &valid);
 	if (valid && value > parameters->int0Parameter) return 1;
 	return 0;
 }
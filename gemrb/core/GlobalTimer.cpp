@@ -30,9 +30,34 @@
 
 namespace GemRB {
 
+// length of a tick in ms
+static tick_t TickLength()
+{
+	return core ? (1000 / core->Time.ticksPerSec) : 66;
+}
+
+tick_t GlobalTimer::Now()
+{
+	if (!fixedStep) {
+		return GetMilliseconds();
+	}
+	fixedTime += TickLength();
+	return fixedTime;
+}
+
+void GlobalTimer::SetFixedStep(bool fixed)
+{
+	fixedStep = fixed;
+	fixedTime = GetMilliseconds();
+	// the switch itself shouldn't count as elapsed time
+	if (startTime) {
+		startTime = fixedTime;
+	}
+}
+
 void GlobalTimer::Freeze()
 {
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (UpdateViewport(thisTime) == false) {
 		return;
@@ -124,7 +149,7 @@ void GlobalTimer::DoStep(int count)
 bool GlobalTimer::UpdateViewport(tick_t thisTime)
 {
 	tick_t advance = thisTime - startTime;
-	tick_t interval = core ? (1000 / core->Time.ticksPerSec) : 66; // length of a tick in ms
+	tick_t interval = TickLength();
 	if (advance < interval) {
 		return false;
 	}
@@ -140,7 +165,7 @@ bool GlobalTimer::Update()
 	Map* map;
 	Game* game;
 	const GameControl* gc;
-	tick_t thisTime = GetMilliseconds();
+	tick_t thisTime = Now();
 
 	if (!startTime) {
 		goto end;
@@ -47,8 +47,13 @@ private:
 	int speed = 0;
 	Region currentVP;
 
+	// in fixed step mode each Update or Freeze advances the clock by exactly one tick
+	bool fixedStep = false;
+	tick_t fixedTime = 0;
+
 	void DoFadeStep(ieDword count);
 	bool UpdateViewport(tick_t time);
+	tick_t Now();
 
 public:
 	GlobalTimer() noexcept = default;
@@ -56,6 +61,8 @@ public:
 	GlobalTimer(GlobalTimer&&) noexcept = default;
 	GlobalTimer& operator=(GlobalTimer&&) noexcept = default;
 
+	void SetFixedStep(bool fixed);
+	bool IsFixedStep() const { return fixedStep; }
 	void Freeze();
 	bool Update();
 	bool IsFading() const;
@@ -29,4 +29,9 @@ ImageFactory::ImageFactory(const ResRef& resref, Holder<Sprite2D> bitmap_)
 {
 }
 
+size_t ImageFactory::GetMemorySize() const
+{
+	return bitmap ? bitmap->Frame.w * bitmap->Frame.h * bitmap->Format().Bpp : 0;
+}
+
 }
@@ -63,12 +63,15 @@
 #include "GUI/Label.h"
 #include "GUI/TextArea.h"
 #include "GUI/WindowManager.h"
+#include "GameScript/GSUtils.h"
 #include "GameScript/GameScript.h"
 #include "Scriptable/Container.h"
 #include "Streams/FileStream.h"
 #include "System/FileFilters.h"
 #include "Video/Video.h"
 
+#include <chrono>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -272,7 +275,8 @@ Interface::Interface(CoreSettings&& cfg)
 	}
 
 	path_t path = config.CachePath;
-	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY)) {
+	// areas, stores and extracted saves get written here all the time
+	if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY, RM_VOLATILE_SOURCE)) {
 		ThrowException("The cache path couldn't be registered, please check!");
 	}
 
@@ -944,6 +948,12 @@ void Interface::DisableMusicPlaylist(size_t SongType)
 /** this is the main loop */
 void Interface::Main()
 {
+	if (config.BenchTicks > 0) {
+		RunBenchmark();
+		QuitGame(0);
+		return;
+	}
+
 	int speed = vars.Get("Mouse Scroll Speed", 10);
 	SetMouseScrollSpeed(speed + 1);
 
@@ -971,53 +981,19 @@ void Interface::Main()
 	fpsRgn.y = 0;
 
 	tick_t frame = 0;
-	tick_t time = GetMilliseconds();
-	tick_t timebase = time;
-	tick_t lastGameUpdate = 0;
+	frameTime = GetMilliseconds();
+	tick_t timebase = frameTime;
 
 	double frames = 0.0;
 
 	do {
-		for (auto it = timers.begin(); it != timers.end();) {
-			if (it->IsRunning()) {
-				it->Update(time);
-				++it;
-			} else {
-				it = timers.erase(it);
-			}
-		}
-
-		//don't change script when quitting is pending
-		while (QuitFlag && QuitFlag != QF_KILL) {
-			HandleFlags();
-		}
+		RunFrame();
 
-		if (gamectrl) {
-			//eventflags are processed only when there is a game
-			if (EventFlag) {
-				HandleEvents();
-			}
-			HandleGUIBehaviour(gamectrl);
-		}
-
-		time = GetMilliseconds();
-
-		static const tick_t oneTick = 1000 / Time.ticksPerSec;
-		bool doGameStateUpdate = time - lastGameUpdate >= oneTick;
-		if (doGameStateUpdate) {
-			GameLoop();
-			// TODO: find other animations that need to be synchronized
-			// we can create a manager for them and everything can be updated at once
-			GlobalColorCycle.AdvanceTime(time);
-			lastGameUpdate = time;
-		}
-
-		winmgr->DrawWindows();
 		if (config.DrawFPS) {
 			frame++;
-			if (time - timebase > 1000) {
-				frames = (frame * 1000.0 / (time - timebase));
-				timebase = time;
+			if (frameTime - timebase > 1000) {
+				frames = (frame * 1000.0 / (frameTime - timebase));
+				timebase = frameTime;
 				frame = 0;
 				fpsstring = fmt::format(u"{:.3f} fps", frames);
 			}
@@ -1825,7 +1801,8 @@ bool Interface::IsFreezed() const
 	return !update_scripts;
 }
 
-void Interface::GameLoop(void)
+// returns true if the game advanced by a tick
+bool Interface::GameLoop(void)
 {
 	TRACY(ZoneScoped);
 	update_scripts = false;
@@ -1846,6 +1823,153 @@ void Interface::GameLoop(void)
 			game->UpdateScripts();
 		}
 	}
+	return do_update;
+}
+
+bool Interface::RunFrame(const std::function<void(FrameStage)>& lap)
+{
+	for (auto it = timers.begin(); it != timers.end();) {
+		if (it->IsRunning()) {
+			it->Update(frameTime);
+			++it;
+		} else {
+			it = timers.erase(it);
+		}
+	}
+
+	//don't change script when quitting is pending
+	while (QuitFlag && QuitFlag != QF_KILL) {
+		HandleFlags();
+	}
+
+	if (gamectrl) {
+		//eventflags are processed only when there is a game
+		if (EventFlag) {
+			HandleEvents();
+		}
+		HandleGUIBehaviour(gamectrl);
+	}
+	if (lap) lap(FrameStage::Events);
+
+	frameTime = GetMilliseconds();
+
+	// a fixed step clock makes every frame a tick, otherwise wait for a tick of real time
+	static const tick_t oneTick = 1000 / Time.ticksPerSec;
+	bool advanced = false;
+	if (timer.IsFixedStep() || frameTime - lastGameUpdate >= oneTick) {
+		advanced = GameLoop();
+		// TODO: find other animations that need to be synchronized
+		// we can create a manager for them and everything can be updated at once
+		GlobalColorCycle.AdvanceTime(frameTime);
+		lastGameUpdate = frameTime;
+	}
+	if (lap) lap(FrameStage::Game);
+
+	audioPlayback->Update();
+	if (lap) lap(FrameStage::Audio);
+
+	winmgr->DrawWindows();
+	if (lap) lap(FrameStage::Draw);
+
+	return advanced;
+}
+
+static void LogBenchTimings(const char* name, std::vector<uint32_t>& samples)
+{
+	if (samples.empty()) return;
+
+	std::sort(samples.begin(), samples.end());
+	uint64_t total = std::accumulate(samples.begin(), samples.end(), uint64_t(0));
+	auto ms = [](uint64_t us) { return us / 1000.0; };
+	Log(MESSAGE, "Bench", "{:<8} avg {:8.3f} ms, median {:8.3f} ms, 95% {:8.3f} ms, max {:8.3f} ms, total {:10.3f} ms",
+	    name, ms(total) / samples.size(), ms(samples[samples.size() / 2]), ms(samples[samples.size() * 95 / 100]), ms(samples.back()), ms(total));
+}
+
+// runs the frames of Main, but the game clock advances by one tick per frame and nothing waits for the display
+void Interface::RunBenchmark()
+{
+	// skip the start menus and go straight into the game
+	QuitFlag &= ~QF_CHANGESCRIPT;
+
+	Holder<SaveGame> save;
+	if (!config.BenchSave.empty()) {
+		save = sgiterator->GetSaveGame(StringFromUtf8(config.BenchSave.c_str()));
+		if (!save) {
+			Log(ERROR, "Bench", "Cannot find save {}!", config.BenchSave);
+			return;
+		}
+	}
+
+	// same seed, same fights
+	RNG::getInstance().Seed(0);
+	SetupLoadGame(save, 0);
+	QuitFlag |= QF_ENTERGAME;
+	HandleFlags();
+	if (!game) {
+		Log(ERROR, "Bench", "Cannot load the game!");
+		return;
+	}
+
+	if (!config.BenchArea.empty()) {
+		ResRef areaRef = config.BenchArea;
+		const Map* area = game->GetMap(areaRef, false);
+		if (!area) {
+			Log(ERROR, "Bench", "Cannot load area {}!", areaRef);
+			return;
+		}
+		Point pos = area->GetEntranceCount() ? area->GetEntrance(0)->Pos : Point(area->GetSize().w / 2, area->GetSize().h / 2);
+		for (int i = 0; i < game->GetPartySize(false); ++i) {
+			MoveBetweenAreasCore(game->GetPC(i, false), areaRef, pos, -1, true);
+		}
+	}
+
+	using BenchClock = std::chrono::steady_clock;
+	auto lap = [](BenchClock::time_point& since) {
+		auto now = BenchClock::now();
+		auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - since).count();
+		since = now;
+		return uint32_t(us);
+	};
+
+	size_t ticks = config.BenchTicks;
+	std::vector<uint32_t> stageTimes[4], swapTimes, frameTimes;
+	for (auto& samples : stageTimes) {
+		samples.reserve(ticks);
+	}
+	swapTimes.reserve(ticks);
+	frameTimes.reserve(ticks);
+
+	// game time no longer depends on how fast the machine is
+	timer.SetFixedStep(true);
+
+	Log(MESSAGE, "Bench", "Running {} ticks in {}...", ticks, game->CurrentArea);
+	size_t tick = 0;
+	size_t updates = 0;
+	frameTime = GetMilliseconds();
+	for (; tick < ticks && !(QuitFlag & QF_KILL); ++tick) {
+		auto frameStart = BenchClock::now();
+		auto since = frameStart;
+
+		updates += RunFrame([&](FrameStage stage) {
+			stageTimes[int(stage)].push_back(lap(since));
+		});
+
+		VideoDriver->SwapBuffers(0);
+		swapTimes.push_back(lap(since));
+
+		frameTimes.push_back(lap(frameStart));
+	}
+
+	timer.SetFixedStep(false);
+
+	// fades and screen shakes still skip updates
+	Log(MESSAGE, "Bench", "Ran {} ticks of {}, {} of them updated the game:", tick, game->CurrentArea, updates);
+	LogBenchTimings("events", stageTimes[int(FrameStage::Events)]);
+	LogBenchTimings("game", stageTimes[int(FrameStage::Game)]);
+	LogBenchTimings("audio", stageTimes[int(FrameStage::Audio)]);
+	LogBenchTimings("draw", stageTimes[int(FrameStage::Draw)]);
+	LogBenchTimings("swap", swapTimes);
+	LogBenchTimings("frame", frameTimes);
 }
 
 /** handles hardcoded gui behaviour */
@@ -50,6 +50,7 @@
 #include "Strings/StringConversion.h"
 #include "Strings/StringMap.h"
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -367,6 +368,9 @@ public:
 	PluginHolder<StringMgr> strings;
 	PluginHolder<StringMgr> strings2;
 	GlobalTimer timer;
+	// the main loop state, kept between frames
+	tick_t frameTime = 0;
+	tick_t lastGameUpdate = 0;
 	int QuitFlag = QF_NORMAL;
 	int EventFlag = EF_CONTROL;
 	Holder<SaveGame> LoadGameIndex;
@@ -684,7 +688,14 @@ private:
 	/** Creates a game control, closes all other windows */
 	GameControl* StartGameControl();
 	/** Executes everything (non graphical) in the main game loop */
-	void GameLoop(void);
+	bool GameLoop(void);
+	/** the parts of a frame, for timing them */
+	enum class FrameStage { Events, Game, Audio, Draw };
+	/** One pass of the main loop up to the buffer swap, returns whether the game advanced.
+	 * The optional lap runs after each stage. */
+	bool RunFrame(const std::function<void(FrameStage)>& lap = nullptr);
+	/** Runs config.BenchTicks frames as fast as possible and logs the timings */
+	void RunBenchmark();
 	/** the internal (without cache) part of GetListFrom2DA */
 	std::vector<ieDword> GetListFrom2DAInternal(const ResRef& resref) const;
 
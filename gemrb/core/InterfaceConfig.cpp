@@ -158,6 +158,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 		}
 	};
 
+	CONFIG_INT("BenchTicks", config.BenchTicks);
 	CONFIG_INT("Bpp", config.Bpp);
 	CONFIG_INT("CaseSensitive", config.CaseSensitive);
 	CONFIG_INT("DoubleClickDelay", config.DoubleClickDelay);
@@ -169,6 +170,7 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_INT("GUIEnhancements", config.GUIEnhancements);
 	CONFIG_INT("Height", config.Height);
 	CONFIG_INT("KeepCache", config.KeepCache);
+	CONFIG_INT("MaxOpenArchives", config.MaxOpenArchives);
 	CONFIG_INT("MaxPartySize", config.MaxPartySize);
 	config.MaxPartySize = std::min(std::max(1, config.MaxPartySize), 10);
 	CONFIG_INT("MouseFeedback", config.MouseFeedback);
@@ -287,6 +289,8 @@ CoreSettings LoadFromDictionary(InterfaceConfig cfg)
 	CONFIG_PATH("SavePath", config.SavePath, config.GamePath);
 
 	CONFIG_STRING("AudioDriver", config.AudioDriverName);
+	CONFIG_STRING("BenchArea", config.BenchArea);
+	CONFIG_STRING("BenchSave", config.BenchSave);
 	CONFIG_STRING("VideoDriver", config.VideoDriverName);
 	CONFIG_STRING("SkipPlugin", config.SkipPlugin);
 	CONFIG_STRING("DelayPlugin", config.DelayPlugin);
@@ -343,6 +347,11 @@ CoreSettings LoadFromArgs(int argc, char* argv[])
 			settings.Set("FullScreen", "1");
 		} else if (stricmp(argv[i], "--color") == 0) {
 			if (i < argc - 1) settings.Set("LogColor", argv[++i]);
+		} else if (stricmp(argv[i], "--bench") == 0) {
+			// headless and silent, so the numbers don't depend on the machine's gpu or sound card
+			if (i < argc - 1) settings.Set("BenchTicks", argv[++i]);
+			settings.Set("VideoDriver", "none");
+			settings.Set("AudioDriver", "none");
 		} else {
 			// assume a path was passed, soft force configless startup
 			settings.Set("GamePath", argv[i]);
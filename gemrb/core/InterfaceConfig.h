@@ -103,6 +103,7 @@ struct CoreSettings {
 	int GUIEnhancements = 23;
 
 	bool KeepCache = false;
+	int MaxOpenArchives = 16; // how many BIFs the KEY importer keeps open
 	bool MultipleQuickSaves = false;
 	bool UseAsLibrary = false;
 	// once GemRB own format is working well, this might be set to 0
@@ -112,6 +113,10 @@ struct CoreSettings {
 	std::string SkipPlugin;
 	std::string DelayPlugin;
 
+	int BenchTicks = 0; // run this many frames headless, then print timings and quit
+	std::string BenchSave; // save slot to benchmark, the default game otherwise
+	std::string BenchArea; // area to move the party to, the saved one otherwise
+
 	int DoubleClickDelay = 250;
 	uint32_t DebugFlags = 0;
 	uint32_t ActionRepeatDelay = 250;
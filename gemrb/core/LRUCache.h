@@ -33,8 +33,14 @@ namespace GemRB {
 
 struct VarEntry;
 
-/* Not thread-safe, PRED is an eviction predicate */
-template<typename T, class PRED>
+/* Every entry takes one unit of the cache size */
+struct LRUEntryCost {
+	template<typename T>
+	size_t operator()(const T&) const { return 1; }
+};
+
+/* Not thread-safe, PRED is an eviction predicate, COST the share of the size an entry takes */
+template<typename T, class PRED, class COST = LRUEntryCost>
 class LRUCache {
 public:
 	using key_t = std::string;
@@ -69,7 +75,9 @@ private:
 	QueueItem* back = nullptr;
 	std::unordered_map<key_t, CacheItem> map;
 	size_t cacheSize;
+	size_t used = 0;
 	PRED predicate;
+	COST cost;
 
 public:
 	explicit LRUCache(size_t size)
@@ -88,10 +96,6 @@ public:
 	template<typename... ARGS>
 	void SetAt(const public_key_t& key, ARGS&&... args)
 	{
-		if (map.size() == cacheSize) {
-			evict();
-		}
-
 		auto insertion =
 			map.emplace(
 				std::piecewise_construct,
@@ -115,6 +119,17 @@ public:
 		}
 
 		insertion.first->second.queueItem = back;
+		used += cost(insertion.first->second.value);
+
+		// never evict what we just added, even if it alone is over the size
+		while (used > cacheSize && front != back) {
+			evict();
+		}
+	}
+
+	size_t Used() const
+	{
+		return used;
 	}
 
 	const T* Lookup(const public_key_t& key) const
@@ -144,6 +159,7 @@ public:
 		auto lookup = map.find(_key);
 
 		if (lookup != map.cend()) {
+			used -= cost(lookup->second.value);
 			unlink(lookup->second.queueItem);
 			delete lookup->second.queueItem;
 			map.erase(lookup);
@@ -155,16 +171,18 @@ public:
 	}
 
 private:
+	/* Evicts the first evictable entry before the newest, or the one just before it. */
 	void evict()
 	{
 		auto next = front;
-		while (next != nullptr) {
+		while (next != back) {
 			auto lookup = map.find(next->key);
 
-			if (next->next == nullptr || predicate(lookup->second.value)) {
+			if (next->next == back || predicate(lookup->second.value)) {
 				/* This is because OpenAL could have done stuff in predicate. */
 				lookup->second.value.evictionNotice();
 
+				used -= cost(lookup->second.value);
 				map.erase(lookup);
 				unlink(next);
 				delete next;
@@ -180,6 +198,8 @@ private:
 		item->prev = back;
 		if (item->prev != nullptr) {
 			item->prev->next = item;
+		} else {
+			this->front = item;
 		}
 		this->back = item;
 	}
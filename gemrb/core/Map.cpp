@@ -42,6 +42,7 @@
 #include "RNG.h"
 #include "SaveGameIterator.h"
 #include "ScriptedAnimation.h"
+#include "SearchMapSpans.h"
 #include "TileMap.h"
 #include "VEFObject.h"
 
@@ -92,6 +93,8 @@ void TileProps::SetTileProp(const SearchmapPoint& p, Property prop, uint8_t val)
 			case Property::SEARCH_MAP:
 				c &= ~searchMapMask;
 				c |= val << searchMapShift;
+				pathClusters.Invalidate(p);
+				searchMapVersion++;
 				break;
 			case Property::MATERIAL:
 				c &= ~materialMapMask;
@@ -172,6 +175,26 @@ void TileProps::PaintSearchMap(const SearchmapPoint& p, PathMapFlags value) cons
 
 	uint32_t& pixel = propPtr[p.y * size.w + p.x];
 	pixel = (pixel & ~searchMapMask) | (uint32_t(value) << propImage->Format().Rshift);
+	// doors and the like change what is passable, unlike the actor circles below
+	pathClusters.Invalidate(p);
+	searchMapVersion++;
+}
+
+// half widths of the rows of a PlotCircle disc of radius r, from -r to r
+static const std::vector<int>& CircleRows(uint16_t r)
+{
+	static std::array<std::vector<int>, MAX_CIRCLESIZE> rows;
+	std::vector<int>& halfWidths = rows[r];
+	if (halfWidths.empty()) {
+		// the circle spans are symmetric around the center, so one width per row covers them all
+		halfWidths.assign(2 * r + 1, -1);
+		const auto points = PlotCircle(BasePoint(), r);
+		for (size_t i = 0; i < points.size(); i += 2) {
+			int& width = halfWidths[points[i].y + r];
+			width = std::max(width, points[i].x);
+		}
+	}
+	return halfWidths;
 }
 
 // Valid values are - PathMapFlags::UNMARKED, PathMapFlags::PC, PathMapFlags::NPC
@@ -185,29 +208,52 @@ void TileProps::PaintSearchMap(const SearchmapPoint& p, uint16_t blocksize, cons
 	// This means that an actor can get closer to a wall than to another
 	// actor. This matches the behaviour of the original BG2.
 
-	auto PaintIfPassable = [this, value](const SearchmapPoint& pos) {
-		PathMapFlags mapval = QuerySearchMap(pos);
-		if (mapval != PathMapFlags::IMPASSABLE) {
-			PathMapFlags newVal = (mapval & PathMapFlags::NOTACTOR) | value;
-			uint32_t& pixel = propPtr[pos.y * size.w + pos.x];
-			pixel = (pixel & ~searchMapMask) | (uint32_t(newVal) << propImage->Format().Rshift);
-		}
-	};
-
 	blocksize = Clamp<uint16_t>(blocksize, 1, MAX_CIRCLESIZE);
-	uint16_t r = blocksize - 1;
+	int r = blocksize - 1;
+	const std::vector<int>& rows = CircleRows(r);
+	const uint32_t shift = propImage->Format().Rshift;
 
-	const auto points = PlotCircle(p, r);
-	for (size_t i = 0; i < points.size(); i += 2) {
-		const BasePoint& p1 = points[i];
-		const BasePoint& p2 = points[i + 1];
-		assert(p1.y == p2.y);
-		assert(p2.x <= p1.x);
+	// tiles off the map read as impassable, so they were never painted anyway
+	for (int dy = -r; dy <= r; ++dy) {
+		int y = p.y + dy;
+		int width = rows[dy + r];
+		if (width < 0 || y < 0 || y >= size.h) continue;
 
-		for (int x = p2.x; x <= p1.x; ++x) {
-			PaintIfPassable(SearchmapPoint(x, p1.y));
+		int x1 = std::max(p.x - width, 0);
+		int x2 = std::min(p.x + width, size.w - 1);
+		if (x1 > x2) continue;
+		PaintSearchMapSpan(propPtr + y * size.w + x1, x2 - x1 + 1, value, shift);
+	}
+}
+
+PathMapFlags TileProps::QueryBlockedInRadius(const SearchmapPoint& p, uint16_t r, bool stopOnImpassable) const noexcept
+{
+	r = std::min<uint16_t>(r, MAX_CIRCLESIZE - 1);
+	const std::vector<int>& rows = CircleRows(r);
+	PathMapFlags ret = PathMapFlags::IMPASSABLE;
+	for (int dy = -int(r); dy <= int(r); ++dy) {
+		int y = p.y + dy;
+		int width = rows[dy + r];
+		if (width < 0) continue;
+
+		int x1 = p.x - width;
+		int x2 = p.x + width;
+		bool clipped = y < 0 || y >= size.h || x1 < 0 || x2 >= size.w;
+		// off-map tiles resolve to impassable
+		if (clipped && stopOnImpassable) {
+			return PathMapFlags::IMPASSABLE;
+		}
+		if (y < 0 || y >= size.h) continue;
+
+		x1 = std::max(x1, 0);
+		x2 = std::min(x2, size.w - 1);
+		if (x1 > x2) continue;
+		bool open = BlockedSearchMapSpan(propPtr + y * size.w + x1, x2 - x1 + 1, searchMapShift, ret);
+		if (!open && stopOnImpassable) {
+			return PathMapFlags::IMPASSABLE;
 		}
 	}
+	return ret;
 }
 
 struct Spawns {
@@ -254,6 +300,14 @@ struct Explore {
 	int VisibilityPerimeter = 0; // calculated from MaxVisibility
 	std::array<std::vector<SearchmapPoint>, MaxVisibility> VisibilityMasks;
 
+	// the row runs of every cell the rays of a range cover, relative to the origin
+	struct Span {
+		int y;
+		int x1;
+		int x2;
+	};
+	std::array<std::vector<Span>, MaxVisibility + 1> VisibilitySpans;
+
 	static const Explore& Get()
 	{
 		static Explore explore;
@@ -275,6 +329,29 @@ private:
 		}
 	}
 
+	void AddSpans()
+	{
+		// the masks stay within MaxVisibility (+1 for LargeFog) of the origin
+		constexpr int center = MaxVisibility + 1;
+		constexpr int side = 2 * center + 1;
+		std::vector<bool> covered(side * side, false);
+		for (int range = 1; range <= MaxVisibility; range++) {
+			for (const SearchmapPoint& p : VisibilityMasks[range - 1]) {
+				covered[(p.y + center) * side + p.x + center] = true;
+			}
+			for (int y = 0; y < side; y++) {
+				for (int x = 0; x < side; x++) {
+					if (!covered[y * side + x]) continue;
+					int x1 = x;
+					while (x + 1 < side && covered[y * side + x + 1]) {
+						x++;
+					}
+					VisibilitySpans[range].push_back({ y - center, x1 - center, x - center });
+				}
+			}
+		}
+	}
+
 	Explore() noexcept
 	{
 		LargeFog = !core->HasFeature(GFFlags::SMALL_FOG);
@@ -325,6 +402,8 @@ private:
 				xc += 2;
 			}
 		}
+
+		AddSpans();
 	}
 };
 
@@ -436,10 +515,12 @@ Map::Map(TileMap* tm, TileProps props, Holder<Sprite2D> sm)
 	  tileProps(std::move(props)),
 	  SmallMap(std::move(sm)),
 	  ExploredBitmap(FogMapSize(), uint8_t(0x00)),
-	  VisibleBitmap(FogMapSize(), uint8_t(0x00))
+	  VisibleBitmap(FogMapSize(), uint8_t(0x00)),
+	  actorGrid(Size(tileProps.GetSize().w * 16, tileProps.GetSize().h * 12))
 {
 	area = this;
 	MasterArea = core->GetGame()->MasterArea(scriptName);
+	tileProps.pathClusters.enabled = gamedata->GetMiscRule("HIERARCHICAL_PATHFINDING") != 0;
 }
 
 Map::~Map(void)
@@ -675,6 +756,9 @@ void Map::UpdateScripts()
 		}
 	}
 
+	// stats can also change without us being told
+	statIndex.Sync(actors);
+
 	GenerateQueues();
 	SortQueues();
 
@@ -1199,7 +1283,7 @@ void Map::DrawMap(const Region& viewport, FogRenderer& fogRenderer, uint32_t dFl
 	// draw reticles before actors
 	core->GetGameControl()->DrawTargetReticles();
 
-	const auto& viewportWalls = WallsIntersectingRegion(viewport, false);
+	WallsIntersectingRegion(viewportWalls, viewport, false);
 	RedrawScreenStencil(viewport, viewportWalls.first);
 	VideoDriver->SetStencilBuffer(wallStencil);
 
@@ -1417,8 +1501,8 @@ void Map::DrawOverheadText() const
 
 void Map::DrawWallPolygons(const Region& viewport) const
 {
-	const auto& viewportWallsAll = WallsIntersectingRegion(viewport, true);
-	for (const auto& poly : viewportWallsAll.first) {
+	WallsIntersectingRegion(wallScratch, viewport, true);
+	for (const auto& poly : wallScratch.first) {
 		const Point& origin = poly->BBox.origin - viewport.origin;
 
 		if (poly->wallFlag & WF_DISABLED) {
@@ -1450,58 +1534,37 @@ void Map::DrawWallPolygons(const Region& viewport) const
 	}
 }
 
-WallPolygonSet Map::WallsIntersectingRegion(Region r, bool includeDisabled, const Point* loc) const
+void Map::WallsIntersectingRegion(WallPolygonSet& walls, const Region& r, bool includeDisabled, const Point* loc) const
 {
-	// WallGroups are collections that contain a reference to all wall polygons intersecting
-	// a 640x480 region moving from top left to bottom right of the map
-
-	constexpr uint32_t groupHeight = 480;
-	constexpr uint32_t groupWidth = 640;
-
-	if (r.x < 0) {
-		r.w += r.x;
-		r.x = 0;
-	}
+	wallGrid.Query(r, walls, includeDisabled, loc);
+}
 
-	if (r.y < 0) {
-		r.h += r.y;
-		r.y = 0;
+// walls only change when a door toggles, so an object that didn't move keeps its classification
+const WallPolygonSet& Map::WallsForObject(const void* object, const Region& bbox, const Point& loc)
+{
+	auto it = objectWalls.find(object);
+	if (it == objectWalls.end()) {
+		// projectiles and vvcs come and go without telling us, so don't let this grow forever
+		if (objectWalls.size() >= 1024) {
+			objectWalls.clear();
+		}
+		it = objectWalls.emplace(object, ObjectWalls()).first;
 	}
 
-	uint32_t pitch = CeilDiv<uint32_t>(TMap->XCellCount * 64, groupWidth);
-	uint32_t ymin = r.y / groupHeight;
-	uint32_t maxHeight = CeilDiv<uint32_t>(TMap->YCellCount * 64, groupHeight);
-	uint32_t ymax = std::min(maxHeight, CeilDiv<uint32_t>(r.y + r.h, groupHeight));
-	uint32_t xmin = r.x / groupWidth;
-	uint32_t xmax = std::min(pitch, CeilDiv<uint32_t>(r.x + r.w, groupWidth));
-
-	WallPolygonSet set;
-	WallPolygonGroup& infront = set.first;
-	WallPolygonGroup& behind = set.second;
-
-	for (uint32_t y = ymin; y < ymax; ++y) {
-		for (uint32_t x = xmin; x < xmax; ++x) {
-			const auto& group = wallGroups[y * pitch + x];
-
-			for (const auto& wp : group) {
-				if ((wp->wallFlag & WF_DISABLED) && includeDisabled == false) {
-					continue;
-				}
-
-				if (!r.IntersectsRegion(wp->BBox)) {
-					continue;
-				}
-
-				if (loc == nullptr || wp->PointBehind(*loc)) {
-					infront.push_back(wp);
-				} else {
-					behind.push_back(wp);
-				}
-			}
-		}
+	ObjectWalls& cached = it->second;
+	if (cached.wallsVersion != wallsVersion || cached.bbox != bbox || cached.loc != loc) {
+		WallsIntersectingRegion(cached.walls, bbox, false, &loc);
+		cached.bbox = bbox;
+		cached.loc = loc;
+		cached.wallsVersion = wallsVersion;
 	}
+	return cached.walls;
+}
 
-	return set;
+void Map::ForgetObject(const void* object)
+{
+	objectStencils.erase(object);
+	objectWalls.erase(object);
 }
 
 void Map::SetDrawingStencilForObject(const void* object, const Region& objectRgn, const WallPolygonSet& walls, const Point& viewPortOrigin)
@@ -1570,7 +1633,7 @@ BlitFlags Map::SetDrawingStencilForScriptable(const Scriptable* scriptable, cons
 		return BlitFlags::NONE;
 	}
 
-	WallPolygonSet walls = WallsIntersectingRegion(bbox, false, &scriptable->Pos);
+	const WallPolygonSet& walls = WallsForObject(scriptable, bbox, scriptable->Pos);
 	SetDrawingStencilForObject(scriptable, bbox, walls, vp.origin);
 
 	// check this after SetDrawingStencilForObject for debug drawing purposes
@@ -1616,7 +1679,7 @@ BlitFlags Map::SetDrawingStencilForAreaAnimation(const AreaAnimation* anim, cons
 	Point p = anim->Pos;
 	p.y += anim->height;
 
-	WallPolygonSet walls = WallsIntersectingRegion(bbox, false, &p);
+	const WallPolygonSet& walls = WallsForObject(anim, bbox, p);
 
 	SetDrawingStencilForObject(anim, bbox, walls, vp.origin);
 
@@ -1639,7 +1702,7 @@ BlitFlags Map::SetDrawingStencilForScriptedAnimation(const ScriptedAnimation* an
 	Point p(anim->Pos.x + anim->XOffset, anim->Pos.y - anim->ZOffset + anim->YOffset);
 	if (anim->SequenceFlags & IE_VVC_HEIGHT) p.y -= height;
 
-	WallPolygonSet walls = WallsIntersectingRegion(bbox, false, &p);
+	const WallPolygonSet& walls = WallsForObject(anim, bbox, p);
 
 	SetDrawingStencilForObject(anim, bbox, walls, viewPort.origin);
 
@@ -1663,7 +1726,7 @@ BlitFlags Map::SetDrawingStencilForProjectile(const Projectile* pro, const Regio
 
 	Point p = pro->GetPos();
 	p.y -= pro->GetZPos();
-	WallPolygonSet walls = WallsIntersectingRegion(bbox, false, &p);
+	const WallPolygonSet& walls = WallsForObject(pro, bbox, p);
 
 	SetDrawingStencilForObject(pro, bbox, walls, viewPort.origin);
 
@@ -1956,6 +2019,8 @@ void Map::AddActor(Actor* actor, bool init)
 	actor->AreaName = scriptName;
 	if (!HasActor(actor)) {
 		actors.push_back(actor);
+		actorGrid.Add(actor, actors.size() - 1);
+		statIndex.Add(actor, actors.size() - 1);
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1994,7 +2059,7 @@ void Map::DeleteActor(size_t idx)
 		//remove the area reference from the actor
 		actor->SetMap(nullptr);
 		actor->AreaName.Reset();
-		objectStencils.erase(actor);
+		ForgetObject(actor);
 		//don't destroy the object in case it is a persistent object
 		//otherwise there is a dead reference causing a crash on save
 		if (game->InStore(actor) < 0) {
@@ -2003,6 +2068,8 @@ void Map::DeleteActor(size_t idx)
 	}
 	//remove the actor from the area's actor list
 	actors.erase(actors.begin() + idx);
+	actorGrid.Rebuild(actors);
+	statIndex.Rebuild(actors);
 }
 
 Scriptable* Map::GetScriptableByGlobalID(ieDword objectID)
@@ -2130,9 +2197,41 @@ std::vector<Scriptable*> Map::GetScriptablesInRect(const Point& p, unsigned int
 	return neighbours;
 }
 
+// the area around p that actors in the given distance could be from, for ActorGrid queries
+static Region ActorSearchRegion(const Point& p, unsigned int distance)
+{
+	Region rgn(p, Size());
+	rgn.ExpandAllSides(int(std::min(distance, 0xffffffu)));
+	return rgn;
+}
+
+// borrows the reusable buffer for ActorGrid query results, nested queries just get a fresh one
+class ActorQuery {
+public:
+	ActorQuery(const ActorGrid& grid, std::vector<size_t>& buffer, const Region& rgn)
+		: buffer(buffer), found(std::move(buffer))
+	{
+		grid.Query(rgn, found);
+	}
+	ActorQuery(const ActorQuery&) = delete;
+	~ActorQuery()
+	{
+		buffer = std::move(found);
+	}
+
+	std::vector<size_t>::const_iterator begin() const { return found.cbegin(); }
+	std::vector<size_t>::const_iterator end() const { return found.cend(); }
+	size_t size() const { return found.size(); }
+
+private:
+	std::vector<size_t>& buffer;
+	std::vector<size_t> found;
+};
+
 Actor* Map::GetActor(const Point& p, int flags, const Movable* checker) const
 {
-	for (auto actor : actors) {
+	for (size_t idx : ActorQuery(actorGrid, actorQueryBuffer, Region(p, Size()))) {
+		Actor* actor = actors[idx];
 		if (!actor->IsOver(p))
 			continue;
 		if (!actor->ValidTarget(flags, checker)) {
@@ -2145,7 +2244,8 @@ Actor* Map::GetActor(const Point& p, int flags, const Movable* checker) const
 
 Actor* Map::GetActorInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* checker) const
 {
-	for (auto actor : actors) {
+	for (size_t idx : ActorQuery(actorGrid, actorQueryBuffer, ActorSearchRegion(p, radius))) {
+		Actor* actor = actors[idx];
 		if (PersonalDistance(p, actor) > radius)
 			continue;
 		if (!actor->ValidTarget(flags, checker)) {
@@ -2159,7 +2259,9 @@ Actor* Map::GetActorInRadius(const Point& p, int flags, unsigned int radius, con
 std::vector<Actor*> Map::GetAllActorsInRadius(const Point& p, int flags, unsigned int radius, const Scriptable* see) const
 {
 	std::vector<Actor*> neighbours;
-	for (auto actor : actors) {
+	// radius is in feet, which are at most 16 pixels long
+	for (size_t idx : ActorQuery(actorGrid, actorQueryBuffer, ActorSearchRegion(p, radius * 16))) {
+		Actor* actor = actors[idx];
 		if (!WithinRange(actor, p, radius)) {
 			continue;
 		}
@@ -2273,7 +2375,7 @@ void Map::PurgeArea(bool items)
 				}
 			}
 			TMap->CleanupContainer(c);
-			objectStencils.erase(c);
+			ForgetObject(c);
 		}
 	}
 	// 3. reset living neutral actors to their HomeLocation,
@@ -2400,8 +2502,10 @@ Actor* Map::GetActorByScriptName(const ieVariable& name) const
 std::vector<Actor*> Map::GetActorsInRect(const Region& rgn, int excludeFlags) const
 {
 	std::vector<Actor*> actorlist;
-	actorlist.reserve(actors.size());
-	for (auto actor : actors) {
+	ActorQuery candidates(actorGrid, actorQueryBuffer, rgn);
+	actorlist.reserve(candidates.size());
+	for (size_t idx : candidates) {
+		Actor* actor = actors[idx];
 		if (!actor->ValidTarget(excludeFlags))
 			continue;
 		if (!rgn.PointInside(actor->Pos) && !actor->IsOver(rgn.origin)) // imagine drawing a tiny box inside the circle, but not over the center
@@ -2525,17 +2629,7 @@ PathMapFlags Map::GetBlockedTile(const SearchmapPoint& p, int size) const
 // p is in tile coords
 PathMapFlags Map::GetBlockedTile(const SearchmapPoint& p) const
 {
-	PathMapFlags ret = tileProps.QuerySearchMap(p);
-	if (bool(ret & PathMapFlags::TRAVEL)) {
-		ret |= PathMapFlags::PASSABLE;
-	}
-	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR))) {
-		ret &= ~PathMapFlags::PASSABLE;
-	}
-	if (bool(ret & PathMapFlags::DOOR_OPAQUE)) {
-		ret = PathMapFlags::SIDEWALL;
-	}
-	return ret;
+	return ResolveBlockedFlags(tileProps.QuerySearchMap(p));
 }
 
 // p is in map coords
@@ -2550,32 +2644,8 @@ PathMapFlags Map::GetBlockedInRadiusTile(const SearchmapPoint& tp, uint16_t size
 	// TODO: recheck that this matches originals
 	// these circles are perhaps slightly different for sizes 7 and up.
 
-	PathMapFlags ret = PathMapFlags::IMPASSABLE;
 	size = Clamp<uint16_t>(size, 2, MAX_CIRCLESIZE);
-	uint16_t r = size - 2;
-
-	std::vector<BasePoint> points;
-	if (r == 0) { // avoid generating 16 identical points
-		points.push_back(tp);
-		points.push_back(tp);
-	} else {
-		points = PlotCircle(tp, r);
-	}
-	for (size_t i = 0; i < points.size(); i += 2) {
-		const BasePoint& p1 = points[i];
-		const BasePoint& p2 = points[i + 1];
-		assert(p1.y == p2.y);
-		assert(p2.x <= p1.x);
-
-		for (int x = p2.x; x <= p1.x; ++x) {
-			PathMapFlags flags = GetBlockedTile(SearchmapPoint(x, p1.y));
-			if (stopOnImpassable && flags == PathMapFlags::IMPASSABLE) {
-				return PathMapFlags::IMPASSABLE;
-			}
-			ret |= flags;
-		}
-	}
-
+	PathMapFlags ret = tileProps.QueryBlockedInRadius(tp, size - 2, stopOnImpassable);
 	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR | PathMapFlags::SIDEWALL))) {
 		ret &= ~PathMapFlags::PASSABLE;
 	}
@@ -2742,8 +2812,8 @@ void Map::DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, con
 
 bool Map::BehindWall(const Point& pos, const Region& r) const
 {
-	const auto& polys = WallsIntersectingRegion(r, false, &pos);
-	return !polys.first.empty();
+	WallsIntersectingRegion(wallScratch, r, false, &pos);
+	return !wallScratch.first.empty();
 }
 
 Priority Map::SetPriority(Actor* actor, bool& hostilesNew, ieDword gameTime) const
@@ -2950,6 +3020,8 @@ void Map::RemoveActor(Actor* actor)
 			actor->SetMap(nullptr);
 			actor->AreaName.Reset();
 			actors.erase(actors.begin() + i);
+			actorGrid.Rebuild(actors);
+			statIndex.Rebuild(actors);
 			return;
 		}
 	}
@@ -3240,6 +3312,22 @@ void Map::SetupAmbients() const
 	ambim.SetAmbients(ambients);
 }
 
+void Map::PrefetchSounds() const
+{
+	core->GetAmbientManager().Prefetch(ambients);
+
+	std::vector<ResRef> sounds;
+	for (const Actor* actor : actors) {
+		actor->GetCombatSounds(sounds);
+	}
+	std::sort(sounds.begin(), sounds.end());
+	sounds.erase(std::unique(sounds.begin(), sounds.end()), sounds.end());
+
+	// only the spatiality matters for decoding
+	auto config = core->GetAudioSettings().ConfigPresetByChannel(SFXChannel::Monster, Point());
+	core->GetAudioPlayback().Prefetch(sounds, config);
+}
+
 void Map::AddMapNote(const Point& point, ieWord color, String text, bool readonly)
 {
 	AddMapNote(point, MapNote(std::move(text), color, readonly));
@@ -3486,6 +3574,8 @@ Size Map::GetSize() const
 void Map::FillExplored(bool explored)
 {
 	ExploredBitmap.fill(explored ? 0xff : 0x00);
+	// cached vision only explores again once it's retraced
+	fogVersion++;
 }
 
 void Map::ExploreTile(const FogPoint& fogP, bool fogOnly)
@@ -3498,10 +3588,12 @@ void Map::ExploreTile(const FogPoint& fogP, bool fogOnly)
 	ExploredBitmap[fogP] = true;
 	if (!fogOnly) {
 		VisibleBitmap[fogP] = true;
+		visibleExtras.push_back(fogP.y * fogSize.w + fogP.x);
 	}
 }
 
-void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
+template<typename VISITOR>
+void Map::TraceVisibility(const SearchmapPoint& pos, int range, int los, VISITOR&& visit) const
 {
 	SearchmapPoint tile;
 	FogPoint fogTile;
@@ -3521,7 +3613,7 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 			fogTile = FogPoint(tile);
 
 			if (!los) {
-				ExploreTile(fogTile, fogOnly);
+				visit(fogTile, fogOnly);
 				continue;
 			}
 
@@ -3543,19 +3635,109 @@ void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
 				Pass--;
 				if (!Pass) break;
 			}
+			visit(fogTile, fogOnly);
+		}
+	}
+}
+
+void Map::ExploreMapChunk(const SearchmapPoint& pos, int range, int los)
+{
+	if (los) {
+		TraceVisibility(pos, range, los, [this](const FogPoint& fogTile, bool fogOnly) {
 			ExploreTile(fogTile, fogOnly);
+		});
+		return;
+	}
+
+	// nothing can block the rays, so reveal the cells they cover a row at a time;
+	// a run of searchmap cells always maps to a run of fog cells
+	const Explore& explore = Explore::Get();
+	const Size fogSize = FogMapSize();
+	range = Clamp(range, 0, int(Explore::MaxVisibility));
+	for (const Explore::Span& span : explore.VisibilitySpans[range]) {
+		FogPoint start(SearchmapPoint(pos.x + span.x1, pos.y + span.y));
+		FogPoint end(SearchmapPoint(pos.x + span.x2, pos.y + span.y));
+		if (start.y < 0 || start.y >= fogSize.h) continue;
+
+		int x1 = std::max(start.x, 0);
+		int x2 = std::min(end.x, fogSize.w - 1);
+		if (x1 > x2) continue;
+
+		int cell = start.y * fogSize.w + x1;
+		int count = x2 - x1 + 1;
+		ExploredBitmap.FillSpan(cell, count, true);
+		VisibleBitmap.FillSpan(cell, count, true);
+		for (int i = 0; i < count; i++) {
+			visibleExtras.push_back(cell + i);
 		}
 	}
 }
 
+void Map::TraceFan(VisibilityFan& fan)
+{
+	const Size fogSize = FogMapSize();
+	if (++fanMark == 0) {
+		std::fill(fanMarks.begin(), fanMarks.end(), 0);
+		fanMark = 1;
+	}
+
+	TraceVisibility(fan.pos, fan.range, 1, [&](const FogPoint& fogTile, bool fogOnly) {
+		if (!fogSize.PointInside(fogTile)) return;
+
+		uint32_t cell = fogTile.y * fogSize.w + fogTile.x;
+		ExploredBitmap[cell] = true;
+		// the rays overlap a lot, but each fan may only hold one reference per cell
+		if (fogOnly || fanMarks[cell] == fanMark) return;
+
+		fanMarks[cell] = fanMark;
+		fan.cells.push_back(cell);
+		if (visibleRefs[cell]++ == 0) {
+			VisibleBitmap[cell] = true;
+		}
+	});
+}
+
+void Map::ReleaseFan(VisibilityFan& fan, bool keepVisible)
+{
+	for (uint32_t cell : fan.cells) {
+		if (--visibleRefs[cell]) continue;
+
+		if (keepVisible) {
+			visibleExtras.push_back(cell);
+		} else {
+			VisibleBitmap[cell] = false;
+		}
+	}
+	fan.cells.clear();
+}
+
 void Map::UpdateFog()
 {
-	TRACY(ZoneScoped);
 	// don't reset in cutscenes just in case the PST ExploreMapChunk action was ran
-	if (!core->InCutSceneMode()) {
-		VisibleBitmap.fill(0);
+	UpdateFog(core->InCutSceneMode());
+}
+
+void Map::UpdateFog(bool keepVisible)
+{
+	TRACY(ZoneScoped);
+	const size_t cellCount = FogMapSize().Area();
+	if (visibleRefs.size() != cellCount) {
+		visibleRefs.assign(cellCount, 0);
+		fanMarks.assign(cellCount, 0);
+		visibilityFans.clear();
+	}
+
+	// the cells seen by fans that moved in the meantime stay lit until then too
+	if (!keepVisible) {
+		for (uint32_t cell : visibleExtras) {
+			if (!visibleRefs[cell]) {
+				VisibleBitmap[cell] = false;
+			}
+		}
+		visibleExtras.clear();
 	}
 
+	++fogUpdate;
 	std::set<Spawn*> potentialSpawns;
 	for (const auto actor : actors) {
 		if (!actor->Modified[IE_EXPLORE]) continue;
@@ -3565,7 +3747,19 @@ void Map::UpdateFog()
 
 		int vis2 = actor->GetVisualRange();
 		if ((state & STATE_BLIND) || (vis2 < 2)) vis2 = 2; //can see only themselves
-		ExploreMapChunk(actor->SMPos, vis2 + actor->GetAnims()->GetCircleSize(), 1);
+		int range = std::min(vis2 + actor->GetAnims()->GetCircleSize(), int(Explore::MaxVisibility));
+
+		// only retrace the actors that moved, changed their vision or had their view changed
+		VisibilityFan& fan = visibilityFans[actor];
+		fan.lastUpdate = fogUpdate;
+		if (fan.pos != actor->SMPos || fan.range != range || fan.searchMapVersion != tileProps.searchMapVersion || fan.fogVersion != fogVersion) {
+			ReleaseFan(fan, keepVisible);
+			fan.pos = actor->SMPos;
+			fan.range = range;
+			fan.searchMapVersion = tileProps.searchMapVersion;
+			fan.fogVersion = fogVersion;
+			TraceFan(fan);
+		}
 
 		Spawn* sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
@@ -3573,6 +3767,16 @@ void Map::UpdateFog()
 		}
 	}
 
+	// actors that left, died or stopped exploring
+	for (auto it = visibilityFans.begin(); it != visibilityFans.end();) {
+		if (it->second.lastUpdate == fogUpdate) {
+			++it;
+			continue;
+		}
+		ReleaseFan(it->second, keepVisible);
+		it = visibilityFans.erase(it);
+	}
+
 	for (Spawn* spawn : potentialSpawns) {
 		TriggerSpawn(spawn);
 	}
@@ -3606,7 +3810,7 @@ int Map::ConsolidateContainers()
 	while (containerCount--) {
 		Container* c = TMap->GetContainer(containerCount);
 		if (TMap->CleanupContainer(c)) {
-			objectStencils.erase(c);
+			ForgetObject(c);
 			continue;
 		}
 		itemcount += c->inventory.GetSlotCount();
@@ -3666,7 +3870,7 @@ void Map::MoveVisibleGroundPiles(const Point& Pos)
 			MergePiles(c, othercontainer);
 			// remove now empty pile immediately
 			if (TMap->CleanupContainer(c)) {
-				objectStencils.erase(c);
+				ForgetObject(c);
 				continue;
 			}
 		}
@@ -23,12 +23,15 @@
 
 #include "exports.h"
 
+#include "ActorGrid.h"
+#include "ActorStatIndex.h"
 #include "Bitmap.h"
 #include "FogRenderer.h"
 #include "MapReverb.h"
 #include "PathFinder.h"
 #include "Polygon.h"
 #include "TableMgr.h"
+#include "WallGrid.h"
 #include "WorldMap.h"
 
 #include "Scriptable/Scriptable.h"
@@ -341,6 +344,11 @@ class GEM_EXPORT TileProps {
 public:
 	static const PixelFormat pixelFormat;
 
+	// connectivity summary of the searchmap for the pathfinder, kept in sync by our setters
+	mutable PathClusters pathClusters;
+	// bumped by the same setters, so vision can tell when walls or doors changed
+	mutable unsigned int searchMapVersion = 0;
+
 	static constexpr uint8_t defaultSearchMap = uint8_t(PathMapFlags::IMPASSABLE);
 	static constexpr uint8_t defaultMaterial = 0; // Black, impassable
 	static constexpr uint8_t defaultElevation = 128; // sea level
@@ -367,6 +375,9 @@ public:
 
 	void PaintSearchMap(const SearchmapPoint&, PathMapFlags value) const noexcept;
 	void PaintSearchMap(const SearchmapPoint& p, uint16_t blocksize, PathMapFlags value) const noexcept;
+	// the resolved flags of a disc of radius r around p ored together, or IMPASSABLE as soon as
+	// stopOnImpassable finds an impassable or off-map tile
+	PathMapFlags QueryBlockedInRadius(const SearchmapPoint& p, uint16_t r, bool stopOnImpassable) const noexcept;
 };
 
 class GEM_EXPORT Map : public Scriptable {
@@ -401,7 +412,11 @@ private:
 
 	std::list<AreaAnimation> animations;
 	std::vector<Actor*> actors;
-	std::vector<WallPolygonGroup> wallGroups;
+	ActorGrid actorGrid;
+	// for the results of actorGrid queries, see ActorQuery
+	mutable std::vector<size_t> actorQueryBuffer;
+	ActorStatIndex statIndex;
+	WallGrid wallGrid;
 	std::list<VEFObject*> vvcCells;
 	std::list<Projectile*> projectiles;
 	std::list<Particles*> particles;
@@ -417,6 +432,37 @@ private:
 	Region stencilViewport;
 
 	std::unordered_map<const void*, std::pair<VideoBufferPtr, Region>> objectStencils;
+	// wall classification of the drawn objects, reused until they move or a door toggles
+	struct ObjectWalls {
+		Region bbox;
+		Point loc;
+		unsigned int wallsVersion = 0;
+		WallPolygonSet walls;
+	};
+	std::unordered_map<const void*, ObjectWalls> objectWalls;
+	unsigned int wallsVersion = 1;
+	WallPolygonSet viewportWalls;
+	mutable WallPolygonSet wallScratch;
+
+	// the fog cells each exploring actor saw on the last update, so UpdateFog only has
+	// to retrace the actors that moved; VisibleBitmap is kept as their reference counted union
+	struct VisibilityFan {
+		SearchmapPoint pos;
+		int range = 0;
+		unsigned int searchMapVersion = 0;
+		unsigned int fogVersion = 0;
+		unsigned int lastUpdate = 0;
+		std::vector<uint32_t> cells;
+	};
+	std::unordered_map<const Actor*, VisibilityFan> visibilityFans;
+	std::vector<uint16_t> visibleRefs;
+	// cells lit by one-off ExploreMapChunk calls, cleared on the next update
+	std::vector<uint32_t> visibleExtras;
+	std::vector<uint32_t> fanMarks;
+	uint32_t fanMark = 0;
+	unsigned int fogUpdate = 0;
+	unsigned int fogVersion = 1;
+	mutable PathScratch pathScratch;
 
 	class MapReverb {
 	public:
@@ -498,11 +544,13 @@ public:
 
 	void SetWallGroups(std::vector<WallPolygonGroup>&& walls)
 	{
-		wallGroups = std::move(walls);
+		wallGrid = WallGrid(walls);
+		wallsVersion++;
 	}
 	void ResetStencilViewport()
 	{
 		stencilViewport = Region();
+		wallsVersion++;
 	}
 	bool BehindWall(const Point&, const Region&) const;
 	void Shout(const Actor* actor, int shoutID, bool global) const;
@@ -511,6 +559,11 @@ public:
 	void InitActors();
 	void MarkVisited(const Actor* actor) const;
 	void AddActor(Actor* actor, bool init);
+	// keeps the proximity queries up to date, call whenever an actor moves
+	void ActorMoved(const Actor* actor) { actorGrid.Update(actor); }
+	// same for IDS object matching, call whenever one of ActorStatIndex::indexedStats changes
+	void ActorStatsChanged(const Actor* actor) { statIndex.Update(actor); }
+	const ActorStatIndex& GetStatIndex() const { return statIndex; }
 	//counts the summons already in the area
 	int CountSummons(ieDword flag, ieDword sex) const;
 	//returns true if an enemy is near P (used in resting/saving)
@@ -608,6 +661,8 @@ public:
 	void ClearSearchMapFor(const Movable* actor) const;
 	/* update VisibleBitmap by resolving vision of all explore actors */
 	void UpdateFog();
+	/* the same, but cells nobody sees anymore stay visible if keepVisible is set (cutscenes) */
+	void UpdateFog(bool keepVisible);
 	//PathFinder
 	/* Finds the nearest passable point */
 	void AdjustPosition(SearchmapPoint& goal, const Size& startingRadius = ZeroSize, int size = -1) const;
@@ -638,6 +693,8 @@ public:
 	//ambients
 	void SetAmbients(std::vector<Ambient*> ambient, MapReverb::id_t reverbID = EFX_PROFILE_REVERB_INVALID);
 	void SetupAmbients() const;
+	/* queues the ambients and the creature combat sounds for background decoding */
+	void PrefetchSounds() const;
 	const std::vector<Ambient*>& GetAmbients() const { return ambients; };
 	const MapReverbProperties& GetReverbProperties() const;
 
@@ -691,7 +748,9 @@ private:
 
 	void RedrawScreenStencil(const Region& vp, const WallPolygonGroup& walls);
 	void DrawStencil(const VideoBufferPtr& stencilBuffer, const Region& vp, const WallPolygonGroup& walls) const;
-	WallPolygonSet WallsIntersectingRegion(Region, bool includeDisabled = false, const Point* loc = nullptr) const;
+	void WallsIntersectingRegion(WallPolygonSet& walls, const Region&, bool includeDisabled = false, const Point* loc = nullptr) const;
+	const WallPolygonSet& WallsForObject(const void* object, const Region& bbox, const Point& loc);
+	void ForgetObject(const void* object);
 
 	void SetDrawingStencilForObject(const void*, const Region&, const WallPolygonSet&, const Point& viewPortOrigin);
 	BlitFlags SetDrawingStencilForScriptable(const Scriptable*, const Region& viewPort);
@@ -707,6 +766,10 @@ private:
 
 	Size PropsSize() const noexcept;
 	Size FogMapSize() const;
+	template<typename VISITOR>
+	void TraceVisibility(const SearchmapPoint& pos, int range, int los, VISITOR&& visit) const;
+	void TraceFan(VisibilityFan& fan);
+	void ReleaseFan(VisibilityFan& fan, bool keepVisible);
 	bool FogTileUncovered(const Point& p, const Bitmap*) const;
 
 	void GenerateQueues();
@@ -728,6 +791,9 @@ private:
 	// same as GetBlocked, but in TileCoords
 	PathMapFlags GetBlockedTile(const SearchmapPoint&, int size) const;
 	PathMapFlags GetBlockedInRadiusTile(const SearchmapPoint&, uint16_t size, bool stopOnImpassable = true) const;
+
+	bool SearchPath(const NavmapPoint& source, NavmapPoint dest, const SearchmapPoint& sightTarget, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, const Region* bounds, std::vector<NavmapPoint>& points) const;
+	bool RefinePath(const NavmapPoint& source, const NavmapPoint& dest, const SearchmapPoint& sightTarget, const std::vector<SearchmapPoint>& waypoints, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, std::vector<NavmapPoint>& points) const;
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include "CharAnimations.h"
 #include "Game.h"
+#include "Geometry.h"
 #include "Interface.h"
 #include "TableMgr.h"
 
@@ -78,7 +79,9 @@ static void InitSparks()
 
 Particles::Particles(int s)
 {
-	points.resize(s);
+	states.resize(s, -1);
+	xs.resize(s);
+	ys.resize(s);
 	/*
 	for (int i=0;i<MAX_SPARK_PHASE;i++) {
 		bitmap[i]=NULL;
@@ -142,18 +145,20 @@ bool Particles::AddNew(const Point& point)
 	}
 	int i = last_insert;
 	while (i--) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (states[i] == -1) {
+			states[i] = st;
+			xs[i] = point.x;
+			ys[i] = point.y;
 			last_insert = i;
 			return false;
 		}
 	}
 	i = size;
 	while (i-- != last_insert) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (states[i] == -1) {
+			states[i] = st;
+			xs[i] = point.x;
+			ys[i] = point.y;
 			last_insert = i;
 			return false;
 		}
@@ -161,87 +166,116 @@ bool Particles::AddNew(const Point& point)
 	return true;
 }
 
-void Particles::Draw(Point p)
+// maps a particle state to its spark phase, raindrops also get their length
+static int SparkPhase(int state, ieByte path, int& length)
 {
-	const Game* game = core->GetGame();
+	if (path == SP_PATH_FLIT || path == SP_PATH_RAIN) {
+		state >>= 4;
+	}
+	if (state >= MAX_SPARK_PHASE) {
+		constexpr int maxDropLength = 10;
+		length = maxDropLength - std::abs(state - MAX_SPARK_PHASE - maxDropLength);
+		return 0;
+	}
+	length = 0;
+	return MAX_SPARK_PHASE - state - 1;
+}
 
-	if (owner) {
-		p -= pos.origin;
+void Particles::DrawFragments(const Point& p) const
+{
+	if (!fragments) {
+		return;
 	}
+
+	const Game* game = core->GetGame();
 	ieWord i = size;
 	while (i--) {
-		if (points[i].state == -1) {
+		if (states[i] == -1) {
 			continue;
 		}
-		int state;
-
-		switch (path) {
-			case SP_PATH_FLIT:
-			case SP_PATH_RAIN:
-				state = points[i].state >> 4;
-				break;
-			default:
-				state = points[i].state;
-				break;
-		}
-
-		int length; //used only for raindrops
-		if (state >= MAX_SPARK_PHASE) {
-			constexpr int maxDropLength = 10;
-			length = maxDropLength - std::abs(state - MAX_SPARK_PHASE - maxDropLength);
-			state = 0;
-		} else {
-			state = MAX_SPARK_PHASE - state - 1;
-			length = 0;
-		}
+		int length;
+		int state = SparkPhase(states[i], path, length);
 		Color clr = color;
 		if (!clr.Packed()) {
 			clr = sparkcolors[colorIdx][state];
 		}
-		switch (type) {
-			case SP_TYPE_BITMAP:
-				/*
-			if (bitmap[state]) {
-				Holder<Sprite2D> frame = bitmap[state]->GetFrame(points[i].state&255);
-				video->BlitGameSprite(frame,
-					points[i].pos.x+screen.x,
-					points[i].pos.y+screen.y, 0, clr,
-					NULL, NULL, &screen);
-			}
-			*/
-				if (fragments) {
-					//IE_ANI_CAST stance has a simple looping animation
-					const auto* anims = fragments->GetAnimation(IE_ANI_CAST, ClampToOrientation(i));
-					if (!anims) {
-						break;
-					}
 
-					const auto anim = anims->at(0);
-					Holder<Sprite2D> nextFrame = anim->GetFrame(anim->GetCurrentFrameIndex());
+		//IE_ANI_CAST stance has a simple looping animation
+		const auto* anims = fragments->GetAnimation(IE_ANI_CAST, ClampToOrientation(i));
+		if (!anims) {
+			continue;
+		}
 
-					BlitFlags flags = BlitFlags::NONE;
-					if (game) game->ApplyGlobalTint(clr, flags);
+		const auto anim = anims->at(0);
+		Holder<Sprite2D> nextFrame = anim->GetFrame(anim->GetCurrentFrameIndex());
 
-					VideoDriver->BlitGameSpriteWithPalette(nextFrame, fragments->GetPartPalette(0),
-									       points[i].pos - p, flags, clr);
-				}
-				break;
+		BlitFlags flags = BlitFlags::NONE;
+		if (game) game->ApplyGlobalTint(clr, flags);
+
+		VideoDriver->BlitGameSpriteWithPalette(nextFrame, fragments->GetPartPalette(0),
+						       Point(xs[i], ys[i]) - p, flags, clr);
+	}
+}
+
+void Particles::Draw(Point p)
+{
+	if (owner) {
+		p -= pos.origin;
+	}
+	if (type == SP_TYPE_BITMAP) {
+		DrawFragments(p);
+		return;
+	}
+
+	// points, lines and circles are all plotted into point batches, one per color,
+	// so the whole effect takes at most MAX_SPARK_PHASE draw calls
+	static const std::vector<BasePoint> circle = PlotCircle(BasePoint(), 2);
+	const bool customColor = color.Packed() != 0;
+	for (auto& batch : batches) {
+		batch.clear();
+	}
+
+	for (ieWord i = 0; i < size; ++i) {
+		if (states[i] == -1) {
+			continue;
+		}
+		int length; //used only for raindrops
+		int state = SparkPhase(states[i], path, length);
+		auto& batch = batches[customColor ? 0 : state];
+		BasePoint origin(xs[i] - p.x, ys[i] - p.y);
+
+		switch (type) {
 			case SP_TYPE_CIRCLE:
-				VideoDriver->DrawCircle(points[i].pos - p, 2, clr);
+				for (const BasePoint& offset : circle) {
+					batch.push_back(origin + offset);
+				}
 				break;
 			case SP_TYPE_POINT:
 			default:
-				VideoDriver->DrawPoint(points[i].pos - p, clr);
+				batch.push_back(origin);
 				break;
 			// this is more like a raindrop
 			case SP_TYPE_LINE:
 				if (length) {
-					int y = length > 3 ? i & 1 : 0;
-					VideoDriver->DrawLine(points[i].pos - p, points[i].pos - p + Point(y, length), clr);
+					// a near vertical line, shifted by dx halfway down
+					int dx = length > 3 ? i & 1 : 0;
+					int step = length < 0 ? -1 : 1;
+					int steps = std::abs(length);
+					for (int k = 0; k <= steps; ++k) {
+						batch.emplace_back(origin.x + (2 * k > steps ? dx : 0), origin.y + k * step);
+					}
 				}
 				break;
 		}
 	}
+
+	for (int state = 0; state < MAX_SPARK_PHASE; ++state) {
+		if (batches[state].empty()) {
+			continue;
+		}
+		const Color& clr = customColor ? color : sparkcolors[colorIdx][state];
+		VideoDriver->DrawPoints(batches[state], clr);
+	}
 }
 
 void Particles::AddParticles(int count)
@@ -308,56 +342,59 @@ int Particles::Update()
 		default:
 			grow = size / 10;
 	}
+	// age all the live elements; a free slot stays at -1
+	int live = 0;
 	for (int i = 0; i < size; i++) {
-		if (points[i].state == -1) {
-			continue;
-		}
-		drawn = true;
-		if (!points[i].state) {
-			grow++;
-		}
-		points[i].state--;
+		int alive = states[i] != -1;
+		live += alive;
+		grow += states[i] == 0;
+		states[i] -= alive;
+	}
+	drawn = live > 0;
 
+	// then move them, one loop per path, so the common ones stay branch free;
+	// positions of free slots don't matter, AddNew overwrites them
+	if (drawn) {
 		switch (path) {
 			case SP_PATH_FALL:
-				points[i].pos.y += 3 + ((i >> 2) & 3);
-				points[i].pos.y %= pos.h;
+				for (int i = 0; i < size; i++) {
+					ys[i] = (ys[i] + 3 + ((i >> 2) & 3)) % pos.h;
+				}
 				break;
 			case SP_PATH_RAIN:
-				points[i].pos.x += pos.w + (i & 1);
-				points[i].pos.x %= pos.w;
-				points[i].pos.y += 3 + ((i >> 2) & 3);
-				points[i].pos.y %= pos.h;
+				for (int i = 0; i < size; i++) {
+					xs[i] = (xs[i] + pos.w + (i & 1)) % pos.w;
+					ys[i] = (ys[i] + 3 + ((i >> 2) & 3)) % pos.h;
+				}
 				break;
 			case SP_PATH_FLIT:
-				if (points[i].state <= MAX_SPARK_PHASE << 4) {
-					break;
+				for (int i = 0; i < size; i++) {
+					if (states[i] <= MAX_SPARK_PHASE << 4) {
+						continue;
+					}
+					xs[i] += core->Roll(1, 3, pos.w - 2);
+					xs[i] %= pos.w;
+					ys[i] += (i & 3) + 1;
 				}
-				points[i].pos.x += core->Roll(1, 3, pos.w - 2);
-				points[i].pos.x %= pos.w;
-				points[i].pos.y += (i & 3) + 1;
 				break;
 			case SP_PATH_EXPL:
-				points[i].pos.y += 1;
+				for (int i = 0; i < size; i++) {
+					ys[i] += states[i] != -1;
+				}
 				break;
 			case SP_PATH_FOUNT:
-				if (points[i].state <= MAX_SPARK_PHASE) {
-					break;
-				}
-				if (points[i].state < (MAX_SPARK_PHASE + pos.h)) {
-					if ((points[i].state & 7) == 7) {
-						points[i].pos.x += (i & 3) - 1;
-					}
-					points[i].pos.y += 2;
-				} else {
-					if ((points[i].state & 7) == 7) {
-						points[i].pos.x += (i & 3) - 1;
-					}
-					points[i].pos.y -= 2;
+				for (int i = 0; i < size; i++) {
+					int state = states[i];
+					int moving = state > MAX_SPARK_PHASE;
+					int drift = moving && (state & 7) == 7 ? (i & 3) - 1 : 0;
+					int rise = state < MAX_SPARK_PHASE + pos.h ? 2 : -2;
+					xs[i] += drift;
+					ys[i] += moving * rise;
 				}
 				break;
 		}
 	}
+
 	if (phase == P_GROW) {
 		AddParticles(grow);
 		drawn = true;
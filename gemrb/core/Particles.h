@@ -36,6 +36,7 @@
 #include "Region.h"
 
 #include <memory>
+#include <vector>
 
 namespace GemRB {
 
@@ -46,12 +47,6 @@ class Scriptable;
 #define P_FADE  1
 #define P_EMPTY 2
 
-// this structure holds data for a single particle element
-struct Element {
-	int state = -1;
-	Point pos;
-};
-
 /**
  * @class Particles 
  * Class holding information about particles and rendering them.
@@ -125,7 +120,14 @@ public:
 	int GetHeight() const { return pos.y + pos.h; }
 
 private:
-	std::vector<Element> points;
+	void DrawFragments(const Point& p) const;
+
+	// particle elements as parallel arrays; a state of -1 marks a free slot
+	std::vector<int> states;
+	std::vector<int> xs;
+	std::vector<int> ys;
+	// points to draw, one batch per spark phase, reused between frames
+	std::vector<BasePoint> batches[MAX_SPARK_PHASE];
 	ieDword timetolive = 0;
 	tick_t lastUpdate = 0;
 	//	ieDword target;    //could be 0, in that case target is pos
@@ -46,7 +46,9 @@
 #include "Scriptable/Actor.h"
 
 #include <array>
+#include <functional>
 #include <limits>
+#include <unordered_map>
 
 namespace GemRB {
 
@@ -230,7 +232,6 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		    s, d,
 		    fmt::WideToChar { caller ? caller->GetShortName() : u"nullptr" },
 		    minDistance, size);
-	bool actorsAreBlocking = flags & PF_ACTORS_ARE_BLOCKING;
 
 	// TODO: we could optimize this function further by doing everything in SearchmapPoint and converting at the end
 	SearchmapPoint smptDest0 { d };
@@ -258,17 +259,75 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 	const Size& mapSize = PropsSize();
 	if (!mapSize.PointInside(smptSource)) return {};
 
-	// Initialize data structures
-	FibonacciHeap<PQNode> open;
-	std::vector<bool> isClosed(mapSize.Area(), false);
-	std::vector<NavmapPoint> parents(mapSize.Area(), Point(0, 0));
-	std::vector<unsigned short> distFromStart(mapSize.Area(), std::numeric_limits<unsigned short>::max());
-	distFromStart[smptSource.y * mapSize.w + smptSource.x] = 0;
-	parents[smptSource.y * mapSize.w + smptSource.x] = nmptSource;
-	open.emplace(PQNode(nmptSource, 0));
+	std::vector<NavmapPoint> points;
 	bool foundPath = false;
+	if (tileProps.pathClusters.enabled) {
+		std::vector<SearchmapPoint> waypoints;
+		auto result = tileProps.pathClusters.FindAbstractPath(tileProps, smptSource, smptDest, waypoints);
+		// with a minimum distance we could still stop somewhere near
+		if (result == PathClusters::Result::UNREACHABLE && !minDistance) {
+			if (InDebugMode(DebugMode::PATHFINDER)) {
+				Log(DEBUG, "FindPath", "Destination is unreachable");
+			}
+			return {};
+		}
+		if (result == PathClusters::Result::FOUND) {
+			foundPath = RefinePath(nmptSource, nmptDest, smptDest0, waypoints, size, minDistance, flags, caller, points);
+		}
+	}
+	// the clusters ignore actors and their sizes, so retry on the whole map
+	if (!foundPath) {
+		points.clear();
+		foundPath = SearchPath(nmptSource, nmptDest, smptDest0, size, minDistance, flags, caller, nullptr, points);
+	}
+
+	if (!foundPath) {
+		if (InDebugMode(DebugMode::PATHFINDER)) {
+			if (caller) {
+				Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar { caller->GetShortName() });
+			} else {
+				Log(DEBUG, "FindPath", "Pathing failed");
+			}
+		}
+		return {};
+	}
+
+	Path resultPath;
+	resultPath.nodes.reserve(points.size());
+	for (size_t i = 0; i < points.size(); ++i) {
+		const NavmapPoint& nmptCurrent = points[i];
+		const NavmapPoint& nmptParent = i ? points[i - 1] : nmptSource;
+		PathNode newStep { nmptCurrent, S };
+		// movement in general allows characters to walk backwards given that
+		// the destination is behind the character (within a threshold), and
+		// that the distance isn't too far away
+		// we approximate that with a relaxed collinearity check and intentionally
+		// skip the first step, otherwise it doesn't help with iwd beetles in ar1015
+		if (flags & PF_BACKAWAY && i + 1 < points.size() && std::abs(area2(nmptCurrent, points[i + 1], nmptParent)) < 300) {
+			newStep.orient = GetOrient(nmptCurrent, nmptParent);
+		} else {
+			newStep.orient = GetOrient(nmptParent, nmptCurrent);
+		}
+		resultPath.AppendStep(std::move(newStep));
+	}
+	return resultPath;
+}
+
+// Theta* from source to dest, appending the nodes of the path (without the source) to points;
+// bounds, in searchmap cells, optionally confine the search
+bool Map::SearchPath(const NavmapPoint& nmptSource, NavmapPoint nmptDest, const SearchmapPoint& smptDest0, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, const Region* bounds, std::vector<NavmapPoint>& points) const
+{
 	static bool usePlainThetaStar = gamedata->GetMiscRule("LAZY_THETA_STAR") == 0;
+	bool actorsAreBlocking = flags & PF_ACTORS_ARE_BLOCKING;
 	unsigned int squaredMinDist = minDistance * minDistance;
+	const Size& mapSize = PropsSize();
+	SearchmapPoint smptSource { nmptSource };
+	SearchmapPoint smptDest { nmptDest };
+
+	// Initialize data structures
+	FibonacciHeap<PQNode> open;
+	PathScratch& nodes = pathScratch;
+	bool foundPath = false;
 
 	// Weighted heuristic. Finds sub-optimal paths but should be quite a bit faster
 	constexpr float_t HEURISTIC_WEIGHT = 1.5;
@@ -282,16 +341,20 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		int crossProduct = std::abs(xDist * dyCross - yDist * dxCross) >> 3;
 		double distance = std::hypot(xDist, yDist);
 		double heuristic = HEURISTIC_WEIGHT * (distance + crossProduct);
-		double estDist = distFromStart[smptChildIdx] + heuristic;
+		double estDist = nodes[smptChildIdx].distFromStart + heuristic;
 		return estDist;
 	};
 
+	nodes.Reset(mapSize.Area());
+	nodes[smptSource.y * mapSize.w + smptSource.x].distFromStart = 0;
+	nodes[smptSource.y * mapSize.w + smptSource.x].parent = nmptSource;
+	open.emplace(PQNode(nmptSource, 0));
 	while (!open.empty()) {
 		NavmapPoint nmptCurrent = open.top().point;
 		open.pop();
 		SearchmapPoint smptCurrent { nmptCurrent };
 		int smptCurrentIdx = smptCurrent.y * mapSize.w + smptCurrent.x;
-		if (parents[smptCurrentIdx].IsZero()) {
+		if (nodes[smptCurrentIdx].parent.IsZero()) {
 			continue;
 		}
 
@@ -300,7 +363,7 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			foundPath = true;
 			break;
 		} else if (minDistance &&
-			   parents[smptCurrentIdx] != nmptCurrent &&
+			   nodes[smptCurrentIdx].parent != nmptCurrent &&
 			   SquaredDistance(nmptCurrent, nmptDest) < squaredMinDist &&
 			   (!(flags & PF_SIGHT) || IsVisibleLOS(smptCurrent, smptDest0, caller))) { // FIXME: should probably be smptDest
 			smptDest = smptCurrent;
@@ -308,16 +371,18 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			foundPath = true;
 			break;
 		}
-		isClosed[smptCurrentIdx] = true;
+		nodes[smptCurrentIdx].closed = true;
 
 		for (size_t i = 0; i < DEGREES_OF_FREEDOM; i++) {
 			NavmapPoint nmptChild(nmptCurrent.x + 16 * dxAdjacent[i], nmptCurrent.y + 12 * dyAdjacent[i]);
 			SearchmapPoint smptChild { nmptChild };
 			// Outside map
 			if (smptChild.x < 0 || smptChild.y < 0 || smptChild.x >= mapSize.w || smptChild.y >= mapSize.h) continue;
+			// Outside the searched part
+			if (bounds && !bounds->PointInside(Point(smptChild.x, smptChild.y))) continue;
 			// Already visited
 			int smptChildIdx = smptChild.y * mapSize.w + smptChild.x;
-			if (isClosed[smptChildIdx]) continue;
+			if (nodes[smptChildIdx].closed) continue;
 
 			PathMapFlags childBlockStatus;
 			if (size > 2) {
@@ -334,46 +399,46 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 			if (childIsUnbumpable) continue;
 
 			SearchmapPoint smptCurrent2 { nmptCurrent };
-			NavmapPoint nmptParent = parents[smptCurrent2.y * mapSize.w + smptCurrent2.x];
+			NavmapPoint nmptParent = nodes[smptCurrent2.y * mapSize.w + smptCurrent2.x].parent;
 			SearchmapPoint smptParent { nmptParent };
-			unsigned short oldDist = distFromStart[smptChildIdx];
+			unsigned short oldDist = nodes[smptChildIdx].distFromStart;
 
 			if (usePlainThetaStar) {
 				// Theta-star path if there is LOS
 				if (IsWalkableTo(nmptParent, nmptChild, actorsAreBlocking, caller)) {
-					unsigned short newDist = distFromStart[smptParent.y * mapSize.w + smptParent.x] + Distance(smptParent, smptChild);
+					unsigned short newDist = nodes[smptParent.y * mapSize.w + smptParent.x].distFromStart + Distance(smptParent, smptChild);
 					if (newDist < oldDist) {
-						parents[smptChildIdx] = nmptParent;
-						distFromStart[smptChildIdx] = newDist;
+						nodes[smptChildIdx].parent = nmptParent;
+						nodes[smptChildIdx].distFromStart = newDist;
 					}
 					// Fall back to A-star path
 				} else {
-					unsigned short newDist = distFromStart[smptCurrent2.y * mapSize.w + smptCurrent2.x] + Distance(smptCurrent2, smptChild);
+					unsigned short newDist = nodes[smptCurrent2.y * mapSize.w + smptCurrent2.x].distFromStart + Distance(smptCurrent2, smptChild);
 					if (newDist < oldDist) {
-						parents[smptChildIdx] = nmptCurrent;
-						distFromStart[smptChildIdx] = newDist;
+						nodes[smptChildIdx].parent = nmptCurrent;
+						nodes[smptChildIdx].distFromStart = newDist;
 					}
 				}
 
-				if (distFromStart[smptChildIdx] < oldDist) {
+				if (nodes[smptChildIdx].distFromStart < oldDist) {
 					PQNode newNode(nmptChild, getHeuristic(smptChild, smptChildIdx));
 					open.emplace(newNode);
 				}
 			} else {
 				// Lazy Theta star*
-				unsigned short newDist = distFromStart[smptParent.y * mapSize.w + smptParent.x] + Distance(smptParent, smptChild);
+				unsigned short newDist = nodes[smptParent.y * mapSize.w + smptParent.x].distFromStart + Distance(smptParent, smptChild);
 				if (newDist < oldDist) {
-					parents[smptChildIdx] = nmptParent;
-					distFromStart[smptChildIdx] = newDist;
+					nodes[smptChildIdx].parent = nmptParent;
+					nodes[smptChildIdx].distFromStart = newDist;
 				}
 
-				if (distFromStart[smptChildIdx] < oldDist) {
+				if (nodes[smptChildIdx].distFromStart < oldDist) {
 					// Theta-star path if there is LOS
 					// so far the searchmap grid appears too coarse to play on, see #2261
 					//if (!IsWalkableTo(smptParent, smptChild, actorsAreBlocking, caller)) {
 					if (!IsWalkableTo(nmptParent, nmptChild, actorsAreBlocking, caller)) {
 						// Fall back to A-star path
-						distFromStart[smptChildIdx] = std::numeric_limits<unsigned short>::max();
+						nodes[smptChildIdx].distFromStart = std::numeric_limits<unsigned short>::max();
 						// Find already visited neighbour with shortest: path from start + path to child
 						for (size_t j = 0; j < DEGREES_OF_FREEDOM; j++) {
 							NavmapPoint nmptVis(nmptChild.x + 16 * dxAdjacent[j], nmptChild.y + 12 * dyAdjacent[j]);
@@ -381,16 +446,16 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 							// Outside map
 							if (smptVis.x < 0 || smptVis.y < 0 || smptVis.x >= mapSize.w || smptVis.y >= mapSize.h) continue;
 							// Only consider already visited
-							if (!isClosed[smptVis.y * mapSize.w + smptVis.x]) continue;
+							if (!nodes[smptVis.y * mapSize.w + smptVis.x].closed) continue;
 
-							unsigned short oldVisDist = distFromStart[smptChildIdx];
-							newDist = distFromStart[smptVis.y * mapSize.w + smptVis.x] + Distance(smptVis, smptChild);
+							unsigned short oldVisDist = nodes[smptChildIdx].distFromStart;
+							newDist = nodes[smptVis.y * mapSize.w + smptVis.x].distFromStart + Distance(smptVis, smptChild);
 							if (newDist < oldVisDist) {
-								parents[smptChildIdx] = nmptVis;
-								distFromStart[smptChildIdx] = newDist;
+								nodes[smptChildIdx].parent = nmptVis;
+								nodes[smptChildIdx].distFromStart = newDist;
 							}
 						}
-						if (distFromStart[smptChildIdx] >= oldDist) continue;
+						if (nodes[smptChildIdx].distFromStart >= oldDist) continue;
 					}
 
 					PQNode newNode(nmptChild, getHeuristic(smptChild, smptChildIdx));
@@ -400,40 +465,322 @@ Path Map::FindPath(const Point& s, const Point& d, unsigned int size, unsigned i
 		}
 	}
 
-	if (foundPath) {
-		Path resultPath;
-		NavmapPoint nmptCurrent = nmptDest;
-		NavmapPoint nmptParent;
-		SearchmapPoint smptCurrent { nmptCurrent };
-		while (!resultPath || nmptCurrent != parents[smptCurrent.y * mapSize.w + smptCurrent.x]) {
-			nmptParent = parents[smptCurrent.y * mapSize.w + smptCurrent.x];
-			PathNode newStep { nmptCurrent, S };
-			// movement in general allows characters to walk backwards given that
-			// the destination is behind the character (within a threshold), and
-			// that the distance isn't too far away
-			// we approximate that with a relaxed collinearity check and intentionally
-			// skip the first step, otherwise it doesn't help with iwd beetles in ar1015
-			if (flags & PF_BACKAWAY && resultPath && std::abs(area2(nmptCurrent, resultPath.GetStep(0).point, nmptParent)) < 300) {
-				newStep.orient = GetOrient(nmptCurrent, nmptParent);
-			} else {
-				newStep.orient = GetOrient(nmptParent, nmptCurrent);
+	if (!foundPath) return false;
+
+	// walk back the parents, the source is its own
+	size_t first = points.size();
+	NavmapPoint nmptCurrent = nmptDest;
+	SearchmapPoint smptCurrent { nmptCurrent };
+	do {
+		points.push_back(nmptCurrent);
+		nmptCurrent = nodes[smptCurrent.y * mapSize.w + smptCurrent.x].parent;
+		smptCurrent = SearchmapPoint(nmptCurrent);
+	} while (nmptCurrent != nodes[smptCurrent.y * mapSize.w + smptCurrent.x].parent);
+	std::reverse(points.begin() + first, points.end());
+	return true;
+}
+
+// Follow the abstract path of PathClusters::FindAbstractPath, with one search per
+// cluster, from where we entered it to the entrance we leave it through
+bool Map::RefinePath(const NavmapPoint& nmptSource, const NavmapPoint& nmptDest, const SearchmapPoint& smptDest0, const std::vector<SearchmapPoint>& waypoints, unsigned int size, unsigned int minDistance, int flags, const Actor* caller, std::vector<NavmapPoint>& points) const
+{
+	const PathClusters& clusters = tileProps.pathClusters;
+	// some room around the cluster, for wider actors squeezing past a border
+	constexpr int MARGIN = PathClusters::CLUSTER_SIZE / 4;
+
+	NavmapPoint current = nmptSource;
+	for (size_t i = 1; i < waypoints.size(); ++i) {
+		const SearchmapPoint& waypoint = waypoints[i];
+		bool last = i + 1 == waypoints.size();
+		// the entrance into a cluster is passed on the way to the one we leave it through
+		if (!last && clusters.ClusterIndex(waypoint) == clusters.ClusterIndex(waypoints[i + 1])) continue;
+
+		if (SearchmapPoint(current) == waypoint) {
+			if (last && current != nmptDest) {
+				points.push_back(nmptDest);
 			}
+			continue;
+		}
+
+		Region bounds = clusters.ClusterBounds(waypoint, MARGIN);
+		NavmapPoint target = last ? nmptDest : NavmapPoint(waypoint.x * 16 + 8, waypoint.y * 12 + 6);
+		if (!SearchPath(current, target, smptDest0, size, last ? minDistance : 0, flags, caller, &bounds, points)) {
+			return false;
+		}
+		current = points.back();
+	}
+	if (points.empty()) return false;
+
+	// the legs meet at the entrances, so pull the path straight across them
+	bool actorsAreBlocking = flags & PF_ACTORS_ARE_BLOCKING;
+	NavmapPoint anchor = nmptSource;
+	size_t kept = 0;
+	for (size_t i = 0; i < points.size(); ++i) {
+		if (i + 1 < points.size() && IsWalkableTo(anchor, points[i + 1], actorsAreBlocking, caller)) continue;
+		anchor = points[i];
+		points[kept++] = anchor;
+	}
+	points.resize(kept);
+	return true;
+}
+
+static bool IsStaticallyPassable(PathMapFlags flags)
+{
+	// mirrors Map::GetBlockedTile, but ignores actors
+	flags &= PathMapFlags::NOTACTOR;
+	if (bool(flags & PathMapFlags::DOOR)) return false;
+	return bool(flags & (PathMapFlags::PASSABLE | PathMapFlags::TRAVEL));
+}
+
+static bool IsStaticallyPassable(const TileProps& props, const Size& mapSize, const SearchmapPoint& p)
+{
+	return mapSize.PointInside(p) && IsStaticallyPassable(props.QuerySearchMap(p));
+}
+
+void PathClusters::Invalidate(const SearchmapPoint& p) noexcept
+{
+	if (clusters.empty() || !mapSize.PointInside(p)) return;
+	uint32_t idx = ClusterIndex(p);
+	clusters[idx].dirty = true;
+
+	// the entrances on a border belong to the clusters on both sides
+	int x = p.x % CLUSTER_SIZE;
+	int y = p.y % CLUSTER_SIZE;
+	if (x == 0 && p.x > 0) clusters[idx - 1].dirty = true;
+	if (x == CLUSTER_SIZE - 1 && p.x + 1 < mapSize.w) clusters[idx + 1].dirty = true;
+	if (y == 0 && p.y > 0) clusters[idx - gridSize.w].dirty = true;
+	if (y == CLUSTER_SIZE - 1 && p.y + 1 < mapSize.h) clusters[idx + gridSize.w].dirty = true;
+}
 
-			resultPath.PrependStep(newStep);
-			nmptCurrent = nmptParent;
+void PathClusters::InvalidateAll() noexcept
+{
+	for (Cluster& cluster : clusters) {
+		cluster.dirty = true;
+	}
+}
 
-			smptCurrent = SearchmapPoint(nmptCurrent);
+void PathClusters::Resize(const Size& size)
+{
+	mapSize = size;
+	gridSize.w = (size.w + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	gridSize.h = (size.h + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	clusters.clear();
+	clusters.resize(gridSize.Area());
+}
+
+Region PathClusters::ClusterBounds(const SearchmapPoint& p, int margin) const noexcept
+{
+	int x = p.x / CLUSTER_SIZE * CLUSTER_SIZE;
+	int y = p.y / CLUSTER_SIZE * CLUSTER_SIZE;
+	return Region(x - margin, y - margin, CLUSTER_SIZE + 2 * margin, CLUSTER_SIZE + 2 * margin);
+}
+
+int PathClusters::CellToLocal(uint32_t idx, uint32_t cell) const noexcept
+{
+	int x = cell % mapSize.w - (idx % gridSize.w) * CLUSTER_SIZE;
+	int y = cell / mapSize.w - (idx / gridSize.w) * CLUSTER_SIZE;
+	return y * CLUSTER_SIZE + x;
+}
+
+PathClusters::Cluster& PathClusters::GetCluster(const TileProps& props, uint32_t idx)
+{
+	if (clusters[idx].dirty) {
+		Build(props, idx);
+	}
+	return clusters[idx];
+}
+
+// walking distances from cell to the rest of the cluster, using the same 4-neighbourhood as FindPath
+void PathClusters::FloodFill(const Cluster& cluster, uint32_t idx, uint32_t cell)
+{
+	fill.fill(Cost(NO_WAY));
+	int start = CellToLocal(idx, cell);
+	if (!cluster.passable[start]) return;
+
+	size_t head = 0;
+	size_t tail = 0;
+	fill[start] = 0;
+	fillQueue[tail++] = start;
+	while (head < tail) {
+		int current = fillQueue[head++];
+		int x = current % CLUSTER_SIZE;
+		int y = current / CLUSTER_SIZE;
+		for (size_t i = 0; i < DEGREES_OF_FREEDOM; i++) {
+			int nx = x + dxAdjacent[i];
+			int ny = y + dyAdjacent[i];
+			if (nx < 0 || ny < 0 || nx >= CLUSTER_SIZE || ny >= CLUSTER_SIZE) continue;
+			int neighbour = ny * CLUSTER_SIZE + nx;
+			if (!cluster.passable[neighbour] || fill[neighbour] != NO_WAY) continue;
+			fill[neighbour] = fill[current] + 1;
+			fillQueue[tail++] = neighbour;
+		}
+	}
+}
+
+// every run of cells passable on both sides of the border gets an entrance in its middle,
+// long ones at both ends instead, so paths along wide openings don't need to detour
+void PathClusters::AddEntrances(const TileProps& props, uint32_t idx, const Point& first, const Point& step, const Point& across)
+{
+	constexpr int LONG_RUN = 6;
+	Cluster& cluster = clusters[idx];
+	int32_t crossing = across.y * mapSize.w + across.x;
+	auto addEntrance = [&](int i) {
+		cluster.entrances.push_back((first.y + step.y * i) * mapSize.w + first.x + step.x * i);
+		cluster.crossings.push_back(crossing);
+	};
+
+	int runStart = -1;
+	for (int i = 0; i <= CLUSTER_SIZE; ++i) {
+		bool open = false;
+		if (i < CLUSTER_SIZE) {
+			SearchmapPoint ours(first.x + step.x * i, first.y + step.y * i);
+			SearchmapPoint theirs(ours.x + across.x, ours.y + across.y);
+			open = IsStaticallyPassable(props, mapSize, ours) && IsStaticallyPassable(props, mapSize, theirs);
+		}
+		if (open) {
+			if (runStart < 0) runStart = i;
+			continue;
 		}
-		return resultPath;
-	} else if (InDebugMode(DebugMode::PATHFINDER)) {
-		if (caller) {
-			Log(DEBUG, "FindPath", "Pathing failed for {}", fmt::WideToChar { caller->GetShortName() });
+		if (runStart < 0) continue;
+
+		int length = i - runStart;
+		if (length < LONG_RUN) {
+			addEntrance(runStart + length / 2);
 		} else {
-			Log(DEBUG, "FindPath", "Pathing failed");
+			addEntrance(runStart);
+			addEntrance(i - 1);
+		}
+		runStart = -1;
+	}
+}
+
+void PathClusters::Build(const TileProps& props, uint32_t idx)
+{
+	Cluster& cluster = clusters[idx];
+	uint32_t cx = idx % gridSize.w;
+	uint32_t cy = idx / gridSize.w;
+	Point origin(cx * CLUSTER_SIZE, cy * CLUSTER_SIZE);
+	for (int y = 0; y < CLUSTER_SIZE; ++y) {
+		for (int x = 0; x < CLUSTER_SIZE; ++x) {
+			cluster.passable[y * CLUSTER_SIZE + x] = IsStaticallyPassable(props, mapSize, SearchmapPoint(origin.x + x, origin.y + y));
+		}
+	}
+
+	// both clusters of a border scan it in the same order, so their entrances face each other
+	constexpr int LAST = CLUSTER_SIZE - 1;
+	cluster.entrances.clear();
+	cluster.crossings.clear();
+	if (cx + 1 < uint32_t(gridSize.w)) AddEntrances(props, idx, Point(origin.x + LAST, origin.y), Point(0, 1), Point(1, 0));
+	if (cy + 1 < uint32_t(gridSize.h)) AddEntrances(props, idx, Point(origin.x, origin.y + LAST), Point(1, 0), Point(0, 1));
+	if (cx > 0) AddEntrances(props, idx, origin, Point(0, 1), Point(-1, 0));
+	if (cy > 0) AddEntrances(props, idx, origin, Point(1, 0), Point(0, -1));
+
+	size_t count = cluster.entrances.size();
+	cluster.costs.resize(count * count);
+	for (size_t i = 0; i < count; ++i) {
+		FloodFill(cluster, idx, cluster.entrances[i]);
+		for (size_t j = 0; j < count; ++j) {
+			cluster.costs[i * count + j] = fill[CellToLocal(idx, cluster.entrances[j])];
+		}
+	}
+	cluster.dirty = false;
+}
+
+// A* over the entrances, with the start and goal tied in by flood fills of their clusters
+PathClusters::Result PathClusters::FindAbstractPath(const TileProps& props, const SearchmapPoint& start, const SearchmapPoint& goal, std::vector<SearchmapPoint>& waypoints)
+{
+	if (props.GetSize() != mapSize) {
+		Resize(props.GetSize());
+	}
+	// also when standing somewhere only actors make passable
+	if (!IsStaticallyPassable(props, mapSize, start) || !IsStaticallyPassable(props, mapSize, goal)) {
+		return Result::NONE;
+	}
+
+	waypoints.clear();
+	uint32_t startCluster = ClusterIndex(start);
+	uint32_t goalCluster = ClusterIndex(goal);
+	uint32_t startCell = start.y * mapSize.w + start.x;
+	uint32_t goalCell = goal.y * mapSize.w + goal.x;
+
+	FloodFill(GetCluster(props, goalCluster), goalCluster, goalCell);
+	const std::array<Cost, CLUSTER_AREA> toGoal = fill;
+	const Cluster& first = GetCluster(props, startCluster);
+	FloodFill(first, startCluster, startCell);
+	if (startCluster == goalCluster && fill[CellToLocal(startCluster, goalCell)] != NO_WAY) {
+		waypoints.push_back(start);
+		waypoints.push_back(goal);
+		return Result::FOUND;
+	}
+
+	// the start and goal aren't part of the graph, so they get their own keys
+	constexpr uint32_t START = std::numeric_limits<uint32_t>::max();
+	constexpr uint32_t GOAL = START - 1;
+	auto estimate = [&](uint32_t cell, uint32_t cost) {
+		if (cell == GOAL) return cost;
+		return cost + std::abs(int(cell % mapSize.w) - goal.x) + std::abs(int(cell / mapSize.w) - goal.y);
+	};
+	auto push = [&](uint32_t node, uint32_t parent, uint32_t cost) {
+		auto it = visited.find(node);
+		if (it != visited.end() && it->second.second <= cost) return;
+		visited[node] = { parent, cost };
+		open.emplace_back(estimate(node, cost), node);
+		std::push_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+	};
+
+	open.clear();
+	visited.clear();
+	visited[START] = { START, 0 };
+	for (uint32_t entrance : first.entrances) {
+		Cost cost = fill[CellToLocal(startCluster, entrance)];
+		if (cost != NO_WAY) push(entrance, START, cost);
+	}
+
+	bool found = false;
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+		QueueEntry entry = open.back();
+		open.pop_back();
+		uint32_t node = entry.second;
+		if (node == GOAL) {
+			found = true;
+			break;
+		}
+		uint32_t cost = visited[node].second;
+		// superseded by a cheaper way here
+		if (entry.first > estimate(node, cost)) continue;
+
+		uint32_t idx = ClusterIndex(SearchmapPoint(node % mapSize.w, node / mapSize.w));
+		const Cluster& cluster = GetCluster(props, idx);
+		if (idx == goalCluster) {
+			Cost rest = toGoal[CellToLocal(idx, node)];
+			if (rest != NO_WAY) push(GOAL, node, cost + rest);
+		}
+		// corner cells can be entrances on two borders
+		size_t count = cluster.entrances.size();
+		for (size_t i = 0; i < count; ++i) {
+			if (cluster.entrances[i] != node) continue;
+
+			push(node + cluster.crossings[i], node, cost + 1);
+			for (size_t j = 0; j < count; ++j) {
+				Cost leg = cluster.costs[i * count + j];
+				if (leg == NO_WAY || cluster.entrances[j] == node) continue;
+				push(cluster.entrances[j], node, cost + leg);
+			}
 		}
 	}
 
-	return {};
+	if (!found) {
+		return Result::UNREACHABLE;
+	}
+
+	waypoints.push_back(goal);
+	for (uint32_t node = visited[GOAL].first; node != START; node = visited[node].first) {
+		waypoints.emplace_back(node % mapSize.w, node / mapSize.w);
+	}
+	waypoints.push_back(start);
+	std::reverse(waypoints.begin(), waypoints.end());
+	return Result::FOUND;
 }
 
 void Map::NormalizeDeltas(float_t& dx, float_t& dy, float_t factor)
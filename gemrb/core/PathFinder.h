@@ -25,11 +25,17 @@
 
 #include "Strings/StringConversion.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
 
+class TileProps;
+
 //searchmap conversion bits
 
 enum class PathMapFlags : uint8_t {
@@ -138,6 +144,115 @@ enum {
 };
 
 
+// Per-node state of Map::FindPath, kept around between searches, so we
+// don't allocate and clear a few searchmap-sized buffers for every path.
+// Each search starts a new generation and nodes stamped with an older one
+// read as fresh, so only the nodes a search touches are ever reset.
+class PathScratch {
+public:
+	struct Node {
+		NavmapPoint parent;
+		unsigned short distFromStart = std::numeric_limits<unsigned short>::max();
+		bool closed = false;
+	};
+
+	void Reset(size_t area)
+	{
+		if (stamps.size() != area) {
+			nodes.resize(area);
+			stamps.assign(area, 0);
+			generation = 0;
+		}
+		if (++generation == 0) {
+			// wrapped around, so old stamps could match again
+			std::fill(stamps.begin(), stamps.end(), 0);
+			generation = 1;
+		}
+	}
+
+	Node& operator[](size_t idx)
+	{
+		if (stamps[idx] != generation) {
+			stamps[idx] = generation;
+			nodes[idx] = Node();
+		}
+		return nodes[idx];
+	}
+
+private:
+	std::vector<Node> nodes;
+	std::vector<uint32_t> stamps;
+	uint32_t generation = 0;
+};
+
+// Abstract graph of the searchmap for a hierarchical search (HPA*, see Botea et al., 2004).
+// The searchmap is cut into square clusters and every run of cells passable on both
+// sides of a border between two clusters gets an entrance (two for long runs), a pair
+// of facing cells. The walking distances between the entrances of a cluster are
+// precomputed, so Map::FindPath can first plan a route over the entrances alone and
+// then refine it leg by leg, with each search confined to a single cluster.
+// Actors are ignored, since they move all the time and can often be bumped, so only
+// changes to the underlying searchmap, like doors opening and closing, invalidate the
+// affected cluster (and the neighbours sharing the touched border). Clusters are
+// (re)built lazily, the first time a search needs them.
+class PathClusters {
+public:
+	static constexpr int CLUSTER_SIZE = 16;
+
+	enum class Result : uint8_t {
+		NONE, // no usable information, search the whole map
+		UNREACHABLE,
+		FOUND
+	};
+
+	// set from the HIERARCHICAL_PATHFINDING misc rule
+	bool enabled = false;
+
+	void Invalidate(const SearchmapPoint& p) noexcept;
+	void InvalidateAll() noexcept;
+
+	// the cells to pass through from start to goal (both included): the start,
+	// the entrances to enter and leave each cluster on the way and the goal
+	Result FindAbstractPath(const TileProps& props, const SearchmapPoint& start, const SearchmapPoint& goal, std::vector<SearchmapPoint>& waypoints);
+	uint32_t ClusterIndex(const SearchmapPoint& p) const noexcept
+	{
+		return (p.y / CLUSTER_SIZE) * gridSize.w + p.x / CLUSTER_SIZE;
+	}
+	// the searchmap cells of the cluster holding p, grown by margin on each side
+	Region ClusterBounds(const SearchmapPoint& p, int margin) const noexcept;
+
+private:
+	using Cost = uint16_t;
+	static constexpr Cost NO_WAY = std::numeric_limits<Cost>::max();
+	static constexpr int CLUSTER_AREA = CLUSTER_SIZE * CLUSTER_SIZE;
+
+	struct Cluster {
+		std::array<bool, CLUSTER_AREA> passable {};
+		std::vector<uint32_t> entrances; // searchmap cell indices on our side of a border
+		std::vector<int32_t> crossings; // cell index offset to the facing entrance
+		std::vector<Cost> costs; // walking distances between entrances, entrances.size() squared
+		bool dirty = true;
+	};
+
+	Size mapSize; // in searchmap cells
+	Size gridSize; // in clusters
+	std::vector<Cluster> clusters;
+
+	// search scratch, kept to avoid reallocating for every query
+	using QueueEntry = std::pair<uint32_t, uint32_t>; // estimate, node
+	std::vector<QueueEntry> open;
+	std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> visited; // node -> (parent, cost)
+	std::array<Cost, CLUSTER_AREA> fill;
+	std::array<int, CLUSTER_AREA> fillQueue;
+
+	void Resize(const Size& size);
+	Cluster& GetCluster(const TileProps& props, uint32_t idx);
+	void Build(const TileProps& props, uint32_t idx);
+	void AddEntrances(const TileProps& props, uint32_t idx, const Point& first, const Point& step, const Point& across);
+	void FloodFill(const Cluster& cluster, uint32_t idx, uint32_t cell);
+	int CellToLocal(uint32_t idx, uint32_t cell) const noexcept;
+};
+
 // Point-distance pair, used by the pathfinder's priority queue
 // to sort nodes by their (heuristic) distance from the destination
 class PQNode {
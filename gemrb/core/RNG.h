@@ -45,6 +45,8 @@ private:
 
 public:
 	static RNG& getInstance();
+	/** For reproducible runs, eg. benchmarks; only affects the calling thread */
+	void Seed(uint32_t seed) noexcept { engine.seed(seed); }
 
 	/**
 	 * It is possible to generate random numbers from [-min, +/-max].
@@ -27,6 +27,9 @@
 #include "ResourceSource.h"
 
 #include "Logging/Logging.h"
+#include "Streams/MemoryStream.h"
+
+#include <algorithm>
 
 namespace GemRB {
 
@@ -85,6 +88,24 @@ path_t TypeExt(SClass_ID type)
 	return extIt->second;
 }
 
+// few are enough, the sources are mostly busy with disk access
+static constexpr size_t PREFETCH_THREADS = 2;
+
+ResourceManager::~ResourceManager()
+{
+	{
+		std::lock_guard<std::mutex> lock(prefetchLock);
+		stopPrefetching = true;
+	}
+	prefetchCV.notify_all();
+	for (auto& thread : prefetchers) {
+		thread.join();
+	}
+	for (const auto& entry : prefetched) {
+		delete entry.second.stream;
+	}
+}
+
 bool ResourceManager::AddSource(const path_t& path, const std::string& description, PluginID type, int flags)
 {
 	PluginHolder<ResourceSource> source = MakePluginHolder<ResourceSource>(type);
@@ -93,19 +114,83 @@ bool ResourceManager::AddSource(const path_t& path, const std::string& descripti
 		return false;
 	}
 
+	bool isVolatile = flags & RM_VOLATILE_SOURCE;
 	if (flags & RM_REPLACE_SAME_SOURCE) {
-		for (auto& path2 : searchPath) {
-			if (description == path2->GetDescription()) {
-				path2 = source;
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (description == searchPath[i]->GetDescription()) {
+				searchPath[i] = source;
+				volatileSources[i] = isVolatile;
 				break;
 			}
 		}
 	} else {
 		searchPath.push_back(source);
+		volatileSources.push_back(isVolatile);
 	}
+	InvalidateLookupCache();
 	return true;
 }
 
+void ResourceManager::InvalidateLookupCache()
+{
+	std::lock_guard<std::mutex> lock(lookupLock);
+	lookupCache.clear();
+}
+
+ResourceManager::LookupStats ResourceManager::GetLookupStats() const
+{
+	std::lock_guard<std::mutex> lock(lookupLock);
+	return lookupStats;
+}
+
+bool ResourceManager::GetCached(StringView resname, SClass_ID type, const TypeID* typeID, CachedLookup& lookup) const
+{
+	// longer names can't be told apart by their ResRef
+	if (resname.length() > sizeof(ResRef) - 1) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(lookupLock);
+	const auto entries = lookupCache.find(ResRef(resname));
+	if (entries != lookupCache.cend()) {
+		for (const auto& entry : entries->second) {
+			if (entry.type == type && entry.typeID == typeID) {
+				lookup = entry;
+				++lookupStats.hits;
+				return true;
+			}
+		}
+	}
+	++lookupStats.misses;
+	return false;
+}
+
+void ResourceManager::SetCached(StringView resname, const CachedLookup& lookup) const
+{
+	if (resname.length() > sizeof(ResRef) - 1) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(lookupLock);
+	lookupCache[ResRef(resname)].push_back(lookup);
+}
+
+void ResourceManager::DropCached(StringView resname, SClass_ID type, const TypeID* typeID) const
+{
+	if (resname.length() > sizeof(ResRef) - 1) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(lookupLock);
+	auto entries = lookupCache.find(ResRef(resname));
+	if (entries == lookupCache.end()) {
+		return;
+	}
+	auto& lookups = entries->second;
+	auto stale = [&](const CachedLookup& entry) { return entry.type == type && entry.typeID == typeID; };
+	lookups.erase(std::remove_if(lookups.begin(), lookups.end(), stale), lookups.end());
+}
+
 static void PrintPossibleFiles(std::string& buffer, StringView ResRef, const TypeID* type)
 {
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
@@ -122,16 +207,33 @@ bool ResourceManager::Exists(const String& resource, SClass_ID type, bool silent
 	return Exists(mbResource, type, silent);
 }
 
+// Lookups remember the first non-volatile source holding the resource (or that none does),
+// so later ones only need to ask that source and any volatile ones in front of it.
+// A hit in a volatile source tells nothing about the rest, so it doesn't fill the cache.
 bool ResourceManager::Exists(StringView ResRef, SClass_ID type, bool silent) const
 {
 	if (ResRef.empty())
 		return false;
-	// TODO: check various caches
-	for (const auto& path : searchPath) {
-		if (path->HasResource(ResRef, type)) {
+
+	CachedLookup lookup {};
+	bool cached = GetCached(ResRef, type, nullptr, lookup);
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (cached && !volatileSources[i]) {
+			if (int(i) == lookup.source) {
+				return true;
+			}
+			continue;
+		}
+		if (searchPath[i]->HasResource(ResRef, type)) {
+			if (!cached && !volatileSources[i]) {
+				SetCached(ResRef, { type, nullptr, int(i), 0 });
+			}
 			return true;
 		}
 	}
+	if (!cached) {
+		SetCached(ResRef, { type, nullptr, -1, 0 });
+	}
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'{}.{}' not found...",
 		    ResRef, TypeExt(type));
@@ -143,15 +245,29 @@ bool ResourceManager::Exists(StringView ResRef, const TypeID* type, bool silent)
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
+
+	CachedLookup lookup {};
+	bool cached = GetCached(ResRef, 0, type, lookup);
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
-	for (const auto& type2 : types) {
-		for (const auto& path : searchPath) {
-			if (path->HasResource(ResRef, type2)) {
+	for (size_t d = 0; d < types.size(); ++d) {
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (cached && !volatileSources[i]) {
+				if (int(i) == lookup.source && int(d) == lookup.desc) {
+					return true;
+				}
+				continue;
+			}
+			if (searchPath[i]->HasResource(ResRef, types[d])) {
+				if (!cached && !volatileSources[i]) {
+					SetCached(ResRef, { 0, type, int(i), int(d) });
+				}
 				return true;
 			}
 		}
 	}
+	if (!cached) {
+		SetCached(ResRef, { 0, type, -1, 0 });
+	}
 	if (!silent) {
 		std::string buffer = fmt::format("Couldn't find '{}'... Tried ", ResRef);
 		PrintPossibleFiles(buffer, ResRef, type);
@@ -164,15 +280,49 @@ DataStream* ResourceManager::GetResourceStream(StringView ResRef, SClass_ID type
 {
 	if (ResRef.empty())
 		return nullptr;
-	for (const auto& path : searchPath) {
+
+	DataStream* ds = nullptr;
+	if (TakePrefetched(ResRef, type, ds)) {
+		if (!silent) {
+			Log(MESSAGE, "ResourceManager", "Found '{}.{}' prefetched.", ResRef, TypeExt(type));
+		}
+		return ds;
+	}
+
+	bool fromVolatile;
+	return SearchResourceStream(ResRef, type, silent, fromVolatile);
+}
+
+DataStream* ResourceManager::SearchResourceStream(StringView ResRef, SClass_ID type, bool silent, bool& fromVolatile) const
+{
+	CachedLookup lookup {};
+	bool cached = GetCached(ResRef, type, nullptr, lookup);
+	for (size_t i = 0; i < searchPath.size(); ++i) {
+		if (cached && !volatileSources[i] && int(i) != lookup.source) {
+			continue;
+		}
+		const auto& path = searchPath[i];
 		DataStream* ds = path->GetResource(ResRef, type);
 		if (ds) {
+			fromVolatile = volatileSources[i];
+			if (!cached && !fromVolatile) {
+				SetCached(ResRef, { type, nullptr, int(i), 0 });
+			}
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.", ResRef, TypeExt(type), path->GetDescription());
 			}
 			return ds;
 		}
 	}
+	fromVolatile = false;
+	// the remembered source lost it, so look everywhere again
+	if (cached && lookup.source >= 0) {
+		DropCached(ResRef, type, nullptr);
+		return SearchResourceStream(ResRef, type, silent, fromVolatile);
+	}
+	if (!cached) {
+		SetCached(ResRef, { type, nullptr, -1, 0 });
+	}
 	if (!silent) {
 		Log(ERROR, "ResourceManager", "Couldn't find '{}.{}'.", ResRef, TypeExt(type));
 	}
@@ -193,20 +343,53 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 		std::sort(types2.begin(), types2.end(), [&prefferedType](auto& a, auto& b) { return (a.GetKeyType() == prefferedType ? true : (a.GetKeyType() < b.GetKeyType())); });
 	}
 
-	for (const auto& type2 : types2) {
-		for (const auto& path : searchPath) {
-			DataStream* str = path->GetResource(ResRef, type2);
+	CachedLookup lookup {};
+	bool cached = GetCached(ResRef, prefferedType, type, lookup);
+	bool foundStream = false;
+	for (size_t d = 0; d < types2.size(); ++d) {
+		DataStream* prefetchedStream = nullptr;
+		if (types2[d].GetKeyType() && TakePrefetched(ResRef, types2[d].GetKeyType(), prefetchedStream)) {
+			foundStream = true;
+			auto res = types2[d].Create(prefetchedStream);
+			if (res) {
+				if (!silent) {
+					Log(MESSAGE, "ResourceManager", "Found '{}.{}' prefetched.", ResRef, types2[d].GetExt());
+				}
+				return res;
+			}
+		}
+
+		for (size_t i = 0; i < searchPath.size(); ++i) {
+			if (cached && !volatileSources[i] && (int(i) != lookup.source || int(d) != lookup.desc)) {
+				continue;
+			}
+			const auto& path = searchPath[i];
+			DataStream* str = path->GetResource(ResRef, types2[d]);
 			if (!str) continue;
 
-			auto res = type2.Create(str);
+			foundStream = true;
+			auto res = types2[d].Create(str);
 			if (!res) continue;
+			if (!cached && !volatileSources[i]) {
+				SetCached(ResRef, { prefferedType, type, int(i), int(d) });
+			}
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '{}.{}' in '{}'.",
-				    ResRef, type2.GetExt(), path->GetDescription());
+				    ResRef, types2[d].GetExt(), path->GetDescription());
 			}
 			return res;
 		}
 	}
+	// the cached source (maybe remembered by Exists) had the file, but it didn't load:
+	// forget it and search everything, so later sources get their chance
+	if (cached && lookup.source >= 0) {
+		DropCached(ResRef, prefferedType, type);
+		return GetResource(ResRef, type, silent, prefferedType);
+	}
+	// a resource that exists, but failed to load, is no miss as far as Exists is concerned
+	if (!cached && !foundStream) {
+		SetCached(ResRef, { prefferedType, type, -1, 0 });
+	}
 	if (!silent) {
 		std::string buffer = fmt::format("Couldn't find '{}'... Tried ", ResRef);
 		PrintPossibleFiles(buffer, ResRef, type);
@@ -215,4 +398,128 @@ ResourceHolder<Resource> ResourceManager::GetResource(StringView ResRef, const T
 	return nullptr;
 }
 
+void ResourceManager::Prefetch(const PrefetchList& resources)
+{
+	std::lock_guard<std::mutex> lock(prefetchLock);
+	for (const auto& resource : resources) {
+		if (resource.first.IsEmpty()) continue;
+
+		PrefetchKey key { resource.first, resource.second };
+		if (prefetched.emplace(key, PrefetchEntry()).second) {
+			prefetchQueue.push_back(key);
+		}
+	}
+
+	while (prefetchers.size() < PREFETCH_THREADS) {
+		prefetchers.emplace_back(&ResourceManager::PrefetchLoop, this);
+	}
+	prefetchCV.notify_all();
+}
+
+void ResourceManager::DiscardPrefetched()
+{
+	std::lock_guard<std::mutex> lock(prefetchLock);
+	prefetchQueue.clear();
+	auto it = prefetched.begin();
+	while (it != prefetched.end()) {
+		// loading ones are finished by their thread and picked up by the next discard
+		if (it->second.state == PrefetchState::Loading) {
+			++it;
+			continue;
+		}
+		delete it->second.stream;
+		it = prefetched.erase(it);
+	}
+}
+
+ResourceManager::PrefetchStats ResourceManager::GetPrefetchStats() const
+{
+	std::lock_guard<std::mutex> lock(prefetchLock);
+	PrefetchStats stats = prefetchStats;
+	stats.queueDepth = prefetchQueue.size();
+	return stats;
+}
+
+void ResourceManager::PrefetchLoop()
+{
+	std::unique_lock<std::mutex> lock(prefetchLock);
+	while (true) {
+		prefetchCV.wait(lock, [this]() { return !prefetchQueue.empty() || stopPrefetching; });
+		if (stopPrefetching) {
+			return;
+		}
+
+		PrefetchKey key = prefetchQueue.front();
+		prefetchQueue.pop_front();
+		auto entry = prefetched.find(key);
+		// already taken over by a direct load
+		if (entry == prefetched.end() || entry->second.state != PrefetchState::Queued) {
+			continue;
+		}
+		entry->second.state = PrefetchState::Loading;
+		lock.unlock();
+
+		bool fromVolatile = false;
+		DataStream* ds = SearchResourceStream(key.ref, key.type, true, fromVolatile);
+		DataStream* mem = nullptr;
+		// volatile sources may change before the stream is used, so leave them to the direct load
+		if (ds && !fromVolatile) {
+			strpos_t size = ds->Size();
+			void* data = malloc(size);
+			if (ds->Read(data, size) == strret_t(size)) {
+				mem = new MemoryStream(ds->originalfile, data, size);
+				mem->filename = ds->filename;
+			} else {
+				free(data);
+			}
+		}
+		delete ds;
+
+		lock.lock();
+		entry = prefetched.find(key);
+		entry->second.stream = mem;
+		entry->second.state = PrefetchState::Done;
+		prefetchCV.notify_all();
+	}
+}
+
+// returns true if the prefetcher delivered the stream, false if it has to be searched for
+bool ResourceManager::TakePrefetched(StringView ResRef, SClass_ID type, DataStream*& stream) const
+{
+	if (ResRef.length() > sizeof(GemRB::ResRef) - 1) {
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock(prefetchLock);
+	if (prefetched.empty()) {
+		return false;
+	}
+
+	PrefetchKey key { GemRB::ResRef(ResRef), type };
+	auto entry = prefetched.find(key);
+	if (entry == prefetched.end()) {
+		return false;
+	}
+
+	if (entry->second.state == PrefetchState::Queued) {
+		// not started yet, it's faster to just load it here
+		++prefetchStats.misses;
+		prefetched.erase(entry);
+		return false;
+	}
+
+	++prefetchStats.hits;
+	// other threads may add entries meanwhile, so don't hold on to the iterator
+	prefetchCV.wait(lock, [this, &key, &entry]() {
+		entry = prefetched.find(key);
+		return entry == prefetched.end() || entry->second.state == PrefetchState::Done;
+	});
+	if (entry == prefetched.end()) {
+		return false;
+	}
+	stream = entry->second.stream;
+	prefetched.erase(entry);
+	return stream != nullptr;
+}
+
 }
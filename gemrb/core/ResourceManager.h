@@ -29,18 +29,32 @@
 
 #include "System/VFS.h"
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
 
 #define RM_REPLACE_SAME_SOURCE 1
+// contents change at runtime, so lookups in it are never cached
+#define RM_VOLATILE_SOURCE 2
 
 class ResourceSource;
 class TypeID;
 
 class GEM_EXPORT ResourceManager {
 public:
+	using PrefetchList = std::vector<std::pair<ResRef, SClass_ID>>;
+
+	ResourceManager() noexcept = default;
+	ResourceManager(const ResourceManager&) = delete;
+	~ResourceManager();
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
 	/**
 	 * Add ResourceSource to search path
 	 * @param[in] path Path to be used for source.
@@ -63,11 +77,82 @@ public:
 		return std::static_pointer_cast<T>(GetResource(resname, &T::ID, silent, prefferedType));
 	}
 
+	struct LookupStats {
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+
+	/** Forgets all cached lookups; needed whenever a source changes its contents */
+	void InvalidateLookupCache();
+	LookupStats GetLookupStats() const;
+
+	struct PrefetchStats {
+		size_t queueDepth = 0;
+		size_t hits = 0; // ready or in flight when asked for
+		size_t misses = 0; // still queued, so loaded directly instead
+	};
+
+	/** Loads the listed resources into memory on worker threads, GetResourceStream will pick them up */
+	void Prefetch(const PrefetchList& resources);
+	/** Drops prefetched resources nobody asked for */
+	void DiscardPrefetched();
+	PrefetchStats GetPrefetchStats() const;
+
 private:
 	/** Returns Resource object associated to given resource */
 	ResourceHolder<Resource> GetResource(StringView resname, const TypeID* type, bool silent = false, ieWord prefferedType = 0) const;
 
+	// where a resource was first found in the non-volatile sources
+	struct CachedLookup {
+		SClass_ID type;
+		const TypeID* typeID;
+		int source; // -1 if not found anywhere
+		int desc; // index into the searched ResourceDesc list
+	};
+
+	bool GetCached(StringView resname, SClass_ID type, const TypeID* typeID, CachedLookup& lookup) const;
+	void SetCached(StringView resname, const CachedLookup& lookup) const;
+	void DropCached(StringView resname, SClass_ID type, const TypeID* typeID) const;
+	DataStream* SearchResourceStream(StringView resname, SClass_ID type, bool silent, bool& fromVolatile) const;
+
+	struct PrefetchKey {
+		ResRef ref;
+		SClass_ID type;
+
+		bool operator==(const PrefetchKey& other) const { return type == other.type && ref == other.ref; }
+	};
+
+	struct PrefetchKeyHash {
+		size_t operator()(const PrefetchKey& key) const { return CstrHashCI()(key.ref) ^ key.type; }
+	};
+
+	enum class PrefetchState {
+		Queued,
+		Loading,
+		Done
+	};
+
+	struct PrefetchEntry {
+		PrefetchState state = PrefetchState::Queued;
+		DataStream* stream = nullptr;
+	};
+
+	void PrefetchLoop();
+	bool TakePrefetched(StringView resname, SClass_ID type, DataStream*& stream) const;
+
 	std::vector<PluginHolder<ResourceSource>> searchPath;
+	std::vector<bool> volatileSources;
+	mutable ResRefMap<std::vector<CachedLookup>> lookupCache;
+	mutable LookupStats lookupStats;
+	mutable std::mutex lookupLock;
+
+	std::vector<std::thread> prefetchers;
+	std::deque<PrefetchKey> prefetchQueue;
+	mutable std::unordered_map<PrefetchKey, PrefetchEntry, PrefetchKeyHash> prefetched;
+	mutable PrefetchStats prefetchStats;
+	mutable std::mutex prefetchLock;
+	mutable std::condition_variable prefetchCV;
+	bool stopPrefetching = false;
 };
 
 }
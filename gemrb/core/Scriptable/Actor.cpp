@@ -2523,6 +2523,9 @@ bool Actor::SetStat(unsigned int StatIndex, stat_t Value, int pcf)
 				(*f)(this, previous, Value);
 			}
 		}
+		if (area && ActorStatIndex::StatSlot(StatIndex) != -1) {
+			area->ActorStatsChanged(this);
+		}
 	}
 	return true;
 }
@@ -2706,6 +2709,60 @@ void Actor::AddEffects(EffectQueue&& fx)
 	RefreshEffects(first, prev);
 }
 
+// most refreshes happen with an unchanged effect queue, so if it holds only effects
+// modifying a single stat each, reapply just those of stats whose inputs changed:
+// the base and starting value, or the effects modifying it
+void Actor::ApplyAllEffects()
+{
+	if (!fxResults) {
+		fxResults = std::make_unique<EffectResultCache>();
+	}
+	EffectResultCache& cache = *fxResults;
+
+	EffectQueue::StatDependencies& deps = cache.nextDeps;
+	if (!fxqueue.GetStatDependencies(deps)) {
+		cache.valid = false;
+		fxqueue.ApplyAllEffects(this);
+		return;
+	}
+
+	const stats_t start = Modified;
+	if (!cache.valid) {
+		fxqueue.ApplyAllEffects(this);
+	} else {
+		EffectQueue::StatSet dirty;
+		for (const auto& stat : deps) {
+			ieDword idx = stat.first;
+			auto old = cache.deps.find(idx);
+			if (old == cache.deps.end() || old->second != stat.second || start[idx] != cache.start[idx] || BaseStats[idx] != cache.base[idx]) {
+				dirty.set(idx);
+			} else {
+				Modified[idx] = cache.after[idx];
+			}
+		}
+		// stats no longer modified by anything kept their starting value
+		fxqueue.ApplyStatEffects(this, dirty);
+
+		if (InDebugMode(DebugMode::EFFECTS)) {
+			// cross-check against the full recompute
+			const stats_t incremental = Modified;
+			Modified = start;
+			fxqueue.ApplyAllEffects(this);
+			for (unsigned int i = 0; i < MAX_STATS; ++i) {
+				if (Modified[i] != incremental[i]) {
+					Log(ERROR, "Actor", "Incremental effect results of {} differ in stat {}: {} vs {}!", fmt::WideToChar { GetName() }, i, incremental[i], Modified[i]);
+				}
+			}
+		}
+	}
+
+	std::swap(cache.deps, cache.nextDeps);
+	cache.base = BaseStats;
+	cache.start = start;
+	cache.after = Modified;
+	cache.valid = true;
+}
+
 void Actor::RefreshEffects(bool first, const stats_t& previous)
 {
 	// some VVCs are controlled by stats (and so by PCFs), the rest have 'effect_owned' set
@@ -2733,7 +2790,7 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 		}
 	}
 
-	fxqueue.ApplyAllEffects(this);
+	ApplyAllEffects();
 
 	const Game* game = core->GetGame();
 	if (previous[IE_PUPPETID]) {
@@ -2863,6 +2920,9 @@ void Actor::RefreshEffects(bool first, const stats_t& previous)
 	if (Immobile()) {
 		timeStartStep = game->Ticks;
 	}
+	if (area) {
+		area->ActorStatsChanged(this);
+	}
 }
 
 void Actor::RefreshEffects()
@@ -4069,7 +4129,7 @@ void Actor::GetHit(int damage, bool killingBlow)
 		if (!VerbalConstant(Verbal::Damage, beingHitCount)) {
 			ResRef sound;
 			GetSoundFromFile(sound, Verbal::Damage);
-			core->GetAudioPlayback().Play(sound, AudioPreset::Spatial, SFXChannel::Monster, Pos);
+			core->GetAudioPlayback().PlayWhenReady(sound, AudioPreset::Spatial, SFXChannel::Monster, Pos);
 		}
 	}
 
@@ -4801,7 +4861,7 @@ void Actor::PlayHitSound(const DataFileMgr* resdata, int damagetype, bool suffix
 			Sound.Format("HIT_0{}{:c}", type, suffix ? '1' : 0);
 		}
 	}
-	core->GetAudioPlayback().Play(Sound, AudioPreset::Spatial, SFXChannel::Hits, Pos);
+	core->GetAudioPlayback().PlayWhenReady(Sound, AudioPreset::Spatial, SFXChannel::Hits, Pos);
 }
 
 // Play swing sounds
@@ -4834,7 +4894,7 @@ void Actor::PlaySwingSound(const WeaponInfo& wi) const
 	// this extra ATTACK in 2das was always played, together with anything else
 	ResRef sound;
 	GetSoundFrom2DA(sound, Verbal::Attack0);
-	core->GetAudioPlayback().Play(sound, AudioPreset::Spatial, SFXChannel::Swings, Pos);
+	core->GetAudioPlayback().PlayWhenReady(sound, AudioPreset::Spatial, SFXChannel::Swings, Pos);
 
 	// the CRE attack was played only if the itemtype was 0/misc to avoid clashes with the hardcoded exceptions
 	// TobExAL and Infinity Sounds prefer both to be played, so we match that, giving more choice to modders
@@ -4869,7 +4929,7 @@ void Actor::PlaySwingSound(const WeaponInfo& wi) const
 			ResRef sound2;
 			GetSoundFromFile(sound2, *vb);
 			if (sound != sound2) {
-				core->GetAudioPlayback().Play(sound2, AudioPreset::Spatial, SFXChannel::Swings, Pos);
+				core->GetAudioPlayback().PlayWhenReady(sound2, AudioPreset::Spatial, SFXChannel::Swings, Pos);
 			}
 		}
 	}
@@ -4882,7 +4942,7 @@ void Actor::PlaySwingSound(const WeaponInfo& wi) const
 		int isChoice = core->Roll(1, isCount, -1) + 2;
 		if (!gamedata->GetItemSound(sound, itemType, AnimRef(), isChoice)) return;
 	}
-	core->GetAudioPlayback().Play(sound, AudioPreset::Spatial, SFXChannel::Swings, Pos);
+	core->GetAudioPlayback().PlayWhenReady(sound, AudioPreset::Spatial, SFXChannel::Swings, Pos);
 }
 
 //Just to quickly inspect debug maximum values
@@ -8749,14 +8809,14 @@ bool Actor::GetSoundFromFile(ResRef& sound, Verbal index) const
 	}
 }
 
-// NOTE: picks a sound at random when the row has several
-bool Actor::GetSoundFrom2DA(ResRef& sound, Verbal index) const
+// finds the animation sound table and the row for the verbal constant
+AutoTable Actor::GetSoundTable(Verbal index, TableMgr::index_t& idx, ResRef& prefix) const
 {
-	if (!anims) return false;
+	if (!anims) return {};
 
 	// check if there is an override (ToBExAL),
 	// otherwise use the base animation prefix
-	ResRef prefix = anims->ResRefBase;
+	prefix = anims->ResRefBase;
 	static AutoTable aniSndOverride = gamedata->LoadTable("anisndex", true);
 	const std::string& row = fmt::format("0x{:4X}", Modified[IE_ANIMATION_ID]);
 	ResRef file = aniSndOverride->QueryField(row, "File");
@@ -8764,9 +8824,9 @@ bool Actor::GetSoundFrom2DA(ResRef& sound, Verbal index) const
 		prefix = file;
 	}
 	AutoTable tab = gamedata->LoadTable(prefix);
-	if (!tab) return false;
+	if (!tab) return {};
 
-	TableMgr::index_t idx = 0;
+	idx = 0;
 	switch (index) {
 		case Verbal::Attack0:
 			idx = 0;
@@ -8806,8 +8866,19 @@ bool Actor::GetSoundFrom2DA(ResRef& sound, Verbal index) const
 			break;
 		default:
 			Log(WARNING, "Actor", "Cannot determine 2DA rowcount for index {} for {}, let us know!", idx, fmt::WideToChar { LongName });
-			return false;
+			return {};
 	}
+	return tab;
+}
+
+// NOTE: picks a sound at random when the row has several
+bool Actor::GetSoundFrom2DA(ResRef& sound, Verbal index) const
+{
+	TableMgr::index_t idx = 0;
+	ResRef prefix;
+	AutoTable tab = GetSoundTable(index, idx, prefix);
+	if (!tab) return false;
+
 	Log(MESSAGE, "Actor", "Getting sound 2da {} entry: {}", prefix, tab->GetRowName(idx));
 	TableMgr::index_t col = RAND<TableMgr::index_t>(0, tab->GetColumnCount(idx) - 1);
 	sound = tab->QueryField(idx, col);
@@ -8815,9 +8886,9 @@ bool Actor::GetSoundFrom2DA(ResRef& sound, Verbal index) const
 	return true;
 }
 
-//Get the monster sound from a global .ini file.
+//Get the monster sound list from a global .ini file.
 //It is ResData.ini in PST and Sounds.ini in IWD/HoW
-bool Actor::GetSoundFromINI(ResRef& sound, Verbal index) const
+StringView Actor::GetSoundINIEntry(Verbal index) const
 {
 	unsigned int animid = BaseStats[IE_ANIMATION_ID];
 	if (core->HasFeature(GFFlags::ONE_BYTE_ANIMID)) {
@@ -8873,10 +8944,14 @@ bool Actor::GetSoundFromINI(ResRef& sound, Verbal index) const
 			break;
 		default:
 			Log(WARNING, "Actor", "Cannot determine INI entry for index {} for {}, let us know!", int(index), fmt::WideToChar { LongName });
-			return false;
+			break;
 	}
+	return resource;
+}
 
-	auto elements = Explode<StringView, ResRef>(resource);
+bool Actor::GetSoundFromINI(ResRef& sound, Verbal index) const
+{
+	auto elements = Explode<StringView, ResRef>(GetSoundINIEntry(index));
 	size_t count = elements.size();
 	if (count == 0) return false;
 
@@ -8932,6 +9007,49 @@ void Actor::GetVerbalConstantSound(ResRef& Sound, Verbal index, bool resolved) c
 	}
 }
 
+// everything the creature can sound like in a fight, without any of the random picks
+void Actor::GetCombatSounds(std::vector<ResRef>& sounds) const
+{
+	auto addSound = [&sounds](const ResRef& sound) {
+		if (!sound.IsEmpty() && !IsStar(sound) && sound != "nosound") {
+			sounds.push_back(sound);
+		}
+	};
+
+	static const Verbal fileVBs[] = { Verbal::Attack0, Verbal::Damage, Verbal::Die };
+	for (Verbal vb : fileVBs) {
+		if (core->HasFeature(GFFlags::RESDATA_INI)) {
+			for (const auto& sound : Explode<StringView, ResRef>(GetSoundINIEntry(vb))) {
+				addSound(sound);
+			}
+			continue;
+		}
+
+		TableMgr::index_t idx = 0;
+		ResRef prefix;
+		AutoTable tab = GetSoundTable(vb, idx, prefix);
+		if (!tab) continue;
+		for (TableMgr::index_t col = 0; col < tab->GetColumnCount(idx); ++col) {
+			addSound(tab->QueryField(idx, col));
+		}
+	}
+
+	// sound sets resolve to folders, see VerbalConstant
+	if (PCStats && !PCStats->SoundSet.IsEmpty()) return;
+
+	static int beingHitCount = gamedata->GetVBData("BEING_HIT_COUNT");
+	static int specialCount = gamedata->GetVBData("SPECIAL_COUNT");
+	const std::pair<Verbal, int> strRefVBs[] = { { Verbal::Damage, beingHitCount }, { Verbal::Die, specialCount } };
+	for (const auto& vbs : strRefVBs) {
+		auto vb = EnumIterator<Verbal>(VCMap[vbs.first]);
+		for (int i = 0; i < vbs.second; ++i, ++vb) {
+			ieStrRef str = GetVerbalConstant(*vb);
+			if (str == ieStrRef::INVALID) break;
+			addSound(core->strings->GetStringBlock(str).Sound);
+		}
+	}
+}
+
 void Actor::SetActionButtonRow(const ActionButtonRow& ar) const
 {
 	for (int i = 0; i < GUIBT_COUNT; i++) {
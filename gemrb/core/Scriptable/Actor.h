@@ -554,6 +554,9 @@ private:
 	bool secondround = false; // true every second round of attack
 	int attacksperround = 0;
 
+	AutoTable GetSoundTable(Verbal index, TableMgr::index_t& idx, ResRef& prefix) const;
+	StringView GetSoundINIEntry(Verbal index) const;
+
 	/** paint the actor itself. Called internally by Draw() */
 	void DrawActorSprite(const Point& p, BlitFlags flags,
 			     const std::vector<AnimationPart>& anims, const Color& tint) const;
@@ -603,7 +606,20 @@ private:
 	/* give kill xp if appropriate */
 	bool ProcessKillXP(const Actor* killerActor, bool grantXP);
 
+	// the results of the last ApplyAllEffects of a queue with only single stat effects,
+	// and what they depended on, so only stats with changed inputs need reapplying
+	struct EffectResultCache {
+		bool valid = false;
+		EffectQueue::StatDependencies deps;
+		EffectQueue::StatDependencies nextDeps; // scratch space for the next refresh
+		stats_t base {};
+		stats_t start {};
+		stats_t after {};
+	};
+	std::unique_ptr<EffectResultCache> fxResults;
+
 	stats_t ResetStats(bool init);
+	void ApplyAllEffects();
 	void RefreshEffects(bool init, const stats_t& prev);
 
 public:
@@ -878,6 +894,8 @@ public:
 	bool GetSoundFromFile(ResRef& sound, Verbal index) const;
 	bool GetSoundFromINI(ResRef& sound, Verbal index) const;
 	bool GetSoundFrom2DA(ResRef& sound, Verbal index) const;
+	/* collects the sounds to decode ahead of combat */
+	void GetCombatSounds(std::vector<ResRef>& sounds) const;
 	/* start bg1-style banter dialog */
 	void HandleInteractV1(const Actor* target);
 	/* generate party banter, return true if successful */
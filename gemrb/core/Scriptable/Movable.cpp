@@ -291,6 +291,9 @@ void Movable::DoStep(unsigned int walkScale, ieDword time)
 	Pos.y += dy;
 	oldPos = Pos;
 	SMPos = SearchmapPoint(Pos);
+	if (actor) {
+		area->ActorMoved(actor);
+	}
 	if (actor && blocksSearch) {
 		auto flag = actor->IsPartyMember() ? PathMapFlags::PC : PathMapFlags::NPC;
 		area->tileProps.PaintSearchMap(SMPos, circleSize, flag);
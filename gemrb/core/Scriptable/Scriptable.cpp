@@ -130,6 +130,22 @@ void Scriptable::SetMap(Map* map)
 		error("Scriptable", "Invalid map set!");
 	}
 	area = map;
+	// positions set before we joined the area didn't reach its actor grid
+	if (!area) return;
+	if (const Actor* actor = Scriptable::As<Actor>(this)) {
+		area->ActorMoved(actor);
+	}
+}
+
+void Scriptable::SetPos(const NavmapPoint& pos)
+{
+	Pos = pos;
+	SMPos = SearchmapPoint(pos);
+	if (!area) return;
+
+	if (const Actor* actor = Scriptable::As<Actor>(this)) {
+		area->ActorMoved(actor);
+	}
 }
 
 //ai is nonzero if this is an actor currently in the party
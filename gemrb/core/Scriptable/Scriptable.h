@@ -413,11 +413,7 @@ public:
 	unsigned int GetVisualRange() const;
 	ieDword GetLocal(const ieVariable& key, ieDword fallback) const;
 	virtual std::string dump() const = 0;
-	void SetPos(const NavmapPoint& pos)
-	{
-		Pos = pos;
-		SMPos = SearchmapPoint(pos);
-	};
+	void SetPos(const NavmapPoint& pos);
 
 private:
 	/* used internally to handle start of spellcasting */
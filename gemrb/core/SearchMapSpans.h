@@ -0,0 +1,75 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SEARCHMAPSPANS_H
+#define SEARCHMAPSPANS_H
+
+#include "EnumFlags.h"
+#include "PathFinder.h"
+
+#include <cstdint>
+
+namespace GemRB {
+
+// Row kernels over the packed pixels of TileProps, used for the actor circles.
+// They are kept branch free, so compilers can vectorize them with whatever SIMD
+// the target has, while all the other platforms still get plain loops.
+
+// what a raw searchmap value means for movement and vision, see Map::GetBlockedTile
+inline PathMapFlags ResolveBlockedFlags(PathMapFlags raw) noexcept
+{
+	uint8_t flags = uint8_t(raw);
+	uint8_t passable = uint8_t(PathMapFlags::PASSABLE);
+	flags |= (flags & uint8_t(PathMapFlags::TRAVEL)) ? passable : 0;
+	flags &= (flags & uint8_t(PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR)) ? uint8_t(~passable) : uint8_t(0xff);
+	flags = (flags & uint8_t(PathMapFlags::DOOR_OPAQUE)) ? uint8_t(PathMapFlags::SIDEWALL) : flags;
+	return PathMapFlags(flags);
+}
+
+// replaces the actor bits of every passable pixel in the row with value
+inline void PaintSearchMapSpan(uint32_t* pixels, int count, PathMapFlags value, uint32_t shift) noexcept
+{
+	const uint32_t mask = 0xffu << shift;
+	const uint32_t keep = uint32_t(PathMapFlags::NOTACTOR);
+	for (int i = 0; i < count; ++i) {
+		uint32_t pixel = pixels[i];
+		uint32_t mapval = (pixel & mask) >> shift;
+		uint32_t painted = (pixel & ~mask) | (((mapval & keep) | uint32_t(value)) << shift);
+		pixels[i] = mapval != uint32_t(PathMapFlags::IMPASSABLE) ? painted : pixel;
+	}
+}
+
+// ors the resolved flags of the row into flags, returns false if any of them was impassable
+inline bool BlockedSearchMapSpan(const uint32_t* pixels, int count, uint32_t shift, PathMapFlags& flags) noexcept
+{
+	uint8_t seen = 0;
+	uint8_t open = 1;
+	for (int i = 0; i < count; ++i) {
+		uint8_t resolved = uint8_t(ResolveBlockedFlags(PathMapFlags((pixels[i] >> shift) & 0xff)));
+		seen |= resolved;
+		open &= resolved != 0;
+	}
+	flags |= PathMapFlags(seen);
+	return open;
+}
+
+}
+
+#endif
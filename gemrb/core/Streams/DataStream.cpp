@@ -166,6 +166,11 @@ DataStream* DataStream::Clone() const noexcept
 	return NULL;
 }
 
+const uint8_t* DataStream::GetView() const noexcept
+{
+	return nullptr;
+}
+
 void DataStream::SetBigEndianness(bool isBE) noexcept
 {
 	IsDataBigEndian = isBE;
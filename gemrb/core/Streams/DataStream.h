@@ -205,6 +205,12 @@ public:
 	 *  Returns NULL on failure.
 	 **/
 	virtual DataStream* Clone() const noexcept;
+	/** Returns the stream contents, if they are already in memory.
+	 *
+	 *  Lets importers parse in place. The data is Size() bytes long and
+	 *  only valid while the stream lives. Returns NULL if it has to be read.
+	 **/
+	virtual const uint8_t* GetView() const noexcept;
 
 	void SetBigEndianness(bool) noexcept;
 
@@ -34,6 +34,9 @@ public:
 	virtual bool OpenRW(const path_t& name) = 0;
 	virtual bool OpenNew(const path_t& name) = 0;
 	virtual strret_t Read(void* ptr, size_t length) = 0;
+	// reads at an absolute offset, without relying on the position of earlier reads,
+	// so several streams can share one read-only handle
+	virtual strret_t ReadAt(void* ptr, size_t length, strpos_t offset) = 0;
 	virtual strret_t Write(const void* ptr, strpos_t length) = 0;
 	virtual bool SeekStart(stroff_t offset) = 0;
 	virtual bool SeekCurrent(stroff_t offset) = 0;
@@ -36,7 +36,7 @@ namespace GemRB {
 #endif
 
 FileStream::FileStream(FileT&& f)
-	: str(std::move(f))
+	: str(std::make_shared<FileT>(std::move(f)))
 {}
 
 FileStream::FileStream(void)
@@ -47,19 +47,32 @@ FileStream::FileStream(void)
 
 DataStream* FileStream::Clone() const noexcept
 {
-	return OpenFile(originalfile);
+	// writing goes through a buffered handle, so those keep to themselves
+	if (!opened || created) {
+		return OpenFile(originalfile);
+	}
+
+	// like a reopened file, the clone starts over on the raw data, so callers
+	// check the encryption again instead of inheriting the shortened size
+	FileStream* fs = new FileStream();
+	fs->str = str;
+	fs->opened = true;
+	fs->size = size + (Encrypted ? 2 : 0);
+	fs->originalfile = originalfile;
+	fs->filename = filename;
+	return fs;
 }
 
 void FileStream::Close()
 {
-	str = FileT();
+	str = nullptr;
 	opened = false;
 	created = false;
 }
 
 void FileStream::FindLength()
 {
-	size = str.Length();
+	size = str->Length();
 	Pos = 0;
 }
 
@@ -71,9 +84,11 @@ bool FileStream::Open(const path_t& fname)
 		return false;
 	}
 
-	if (!str.OpenRO(fname)) {
+	auto file = std::make_shared<FileT>();
+	if (!file->OpenRO(fname)) {
 		return false;
 	}
+	str = std::move(file);
 	opened = true;
 	created = false;
 	FindLength();
@@ -86,9 +101,11 @@ bool FileStream::Modify(const path_t& fname)
 {
 	Close();
 
-	if (!str.OpenRW(fname)) {
+	auto file = std::make_shared<FileT>();
+	if (!file->OpenRW(fname)) {
 		return false;
 	}
+	str = std::move(file);
 	opened = true;
 	created = true;
 	FindLength();
@@ -118,9 +135,11 @@ bool FileStream::Create(const path_t& path)
 	originalfile = path;
 	filename = ExtractFileFromPath(path);
 
-	if (!str.OpenNew(originalfile)) {
+	auto file = std::make_shared<FileT>();
+	if (!file->OpenNew(originalfile)) {
 		return false;
 	}
+	str = std::move(file);
 	opened = true;
 	created = true;
 	Pos = 0;
@@ -138,8 +157,9 @@ strret_t FileStream::Read(void* dest, strpos_t length)
 	if (Pos + length > size) {
 		return Error;
 	}
-	size_t c = str.Read(dest, length);
-	if (c != length) {
+	// read-only handles may be shared with clones, so they don't keep a position
+	strret_t c = created ? str->Read(dest, length) : str->ReadAt(dest, length, Pos + (Encrypted ? 2 : 0));
+	if (c != strret_t(length)) {
 		return Error;
 	}
 	if (Encrypted) {
@@ -156,7 +176,7 @@ strret_t FileStream::Write(const void* src, strpos_t length)
 	}
 	// do encryption here if needed
 
-	size_t c = str.Write(src, length);
+	size_t c = str->Write(src, length);
 	if (c != length) {
 		return Error;
 	}
@@ -174,22 +194,22 @@ strret_t FileStream::Seek(stroff_t newpos, strpos_t type)
 	}
 	switch (type) {
 		case GEM_STREAM_END:
-			str.SeekStart(size - newpos);
 			Pos = size - newpos;
 			break;
 		case GEM_CURRENT_POS:
-			str.SeekCurrent(newpos);
 			Pos += newpos;
 			break;
 
 		case GEM_STREAM_START:
-			str.SeekStart(newpos);
 			Pos = newpos;
 			break;
 
 		default:
 			return Error;
 	}
+	if (created) {
+		str->SeekStart(Pos);
+	}
 	if (Pos > size) {
 		Log(ERROR, "Streams", "Invalid seek position {} in file {} (limit: {})", Pos, filename, size);
 		return Error;
@@ -33,6 +33,8 @@
 
 #include "DataStream.h"
 
+#include <memory>
+
 #ifdef WIN32
 	#include "../../platforms/windows/WindowsFile.h"
 using FileT = GemRB::WindowsFile;
@@ -46,11 +48,12 @@ namespace GemRB {
 /**
  * @class FileStream
  * Reads and writes data from/to files on a filesystem
+ * Clones of read-only streams share the file handle and read at their own position.
  */
 
 class GEM_EXPORT FileStream : public DataStream {
 private:
-	FileT str;
+	std::shared_ptr<FileT> str;
 	bool opened = true;
 	bool created = true;
 
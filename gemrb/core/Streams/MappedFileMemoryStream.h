@@ -21,6 +21,8 @@
 #include "DataStream.h"
 #include "MemoryStream.h"
 
+#include <memory>
+
 namespace GemRB {
 
 class GEM_EXPORT MappedFileMemoryStream : public MemoryStream {
@@ -36,9 +38,20 @@ public:
 	DataStream* Clone() const noexcept override;
 
 private:
-	void* fileHandle;
-	bool fileOpened;
-	bool fileMapped;
+	// clones share the mapping instead of opening and mapping the file again
+	struct Mapping {
+		void* fileHandle = nullptr;
+		bool fileOpened = false;
+		bool fileMapped = false;
+		void* data = nullptr;
+		strpos_t size = 0;
+
+		~Mapping();
+	};
+
+	std::shared_ptr<Mapping> mapping;
+
+	MappedFileMemoryStream(const std::string& fileName, std::shared_ptr<Mapping> mapping);
 };
 
 }
@@ -44,6 +44,12 @@ DataStream* MemoryStream::Clone() const noexcept
 	return new MemoryStream(originalfile.c_str(), copy, size);
 }
 
+const uint8_t* MemoryStream::GetView() const noexcept
+{
+	// encrypted data is only usable through Read
+	return Encrypted ? nullptr : reinterpret_cast<const uint8_t*>(data);
+}
+
 strret_t MemoryStream::Read(void* dest, strpos_t length)
 {
 	//we don't allow partial reads anyway, so it isn't a problem that
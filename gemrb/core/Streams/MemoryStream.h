@@ -35,6 +35,7 @@ public:
 	MemoryStream(const path_t& name, void* data, strpos_t size);
 	~MemoryStream() override;
 	DataStream* Clone() const noexcept override;
+	const uint8_t* GetView() const noexcept override;
 
 	strret_t Read(void* dest, strpos_t length) override;
 	strret_t Write(const void* src, strpos_t length) override;
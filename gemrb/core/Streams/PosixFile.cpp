@@ -19,7 +19,12 @@
 
 #include "PosixFile.h"
 
+#include "config.h"
+
 #include <algorithm>
+#ifdef HAVE_PREAD
+	#include <unistd.h>
+#endif
 
 namespace GemRB {
 
@@ -74,6 +79,20 @@ strret_t PosixFile::Read(void* ptr, size_t length)
 	return fread(ptr, 1, length, file);
 }
 
+strret_t PosixFile::ReadAt(void* ptr, size_t length, strpos_t offset)
+{
+#ifdef HAVE_PREAD
+	// bypasses the stdio buffer, fine as long as nothing writes through it
+	return pread(fileno(file), ptr, length, offset);
+#else
+	std::lock_guard<std::mutex> lock(seekLock);
+	if (fseek(file, offset, SEEK_SET)) {
+		return -1;
+	}
+	return fread(ptr, 1, length, file);
+#endif
+}
+
 strret_t PosixFile::Write(const void* ptr, strpos_t length)
 {
 	return fwrite(ptr, 1, length, file);
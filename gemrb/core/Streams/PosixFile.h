@@ -23,12 +23,16 @@
 #include "File.h"
 
 #include <cstdio>
+#include <mutex>
 
 namespace GemRB {
 
 class GEM_EXPORT PosixFile : public File {
 private:
 	FILE* file = nullptr;
+	// clones share the handle, so without pread the seek and read of ReadAt have to stay together
+	// (always a member, since not every includer sees HAVE_PREAD)
+	std::mutex seekLock;
 
 public:
 	PosixFile() noexcept = default;
@@ -44,6 +48,7 @@ public:
 	bool OpenRW(const path_t& name) override;
 	bool OpenNew(const path_t& name) override;
 	strret_t Read(void* ptr, size_t length) override;
+	strret_t ReadAt(void* ptr, size_t length, strpos_t offset) override;
 	strret_t Write(const void* ptr, strpos_t length) override;
 	bool SeekStart(stroff_t offset) override;
 	bool SeekCurrent(stroff_t offset) override;
@@ -47,6 +47,15 @@ DataStream* SlicedStream::Clone() const noexcept
 	return new SlicedStream(str, startpos, size);
 }
 
+const uint8_t* SlicedStream::GetView() const noexcept
+{
+	const uint8_t* parent = str->GetView();
+	if (!parent || Encrypted) {
+		return nullptr;
+	}
+	return parent + startpos;
+}
+
 strret_t SlicedStream::Read(void* dest, strpos_t length)
 {
 	//we don't allow partial reads anyway, so it isn't a problem that
@@ -102,11 +111,18 @@ DataStream* SliceStream(DataStream* str, strpos_t startpos, strpos_t size, bool
 		strpos_t oldpos;
 		if (preservepos)
 			oldpos = str->GetPos();
-		str->Seek(startpos, GEM_STREAM_START);
 		char* data = (char*) malloc(size);
-		str->Read(data, size);
-		if (preservepos)
-			str->Seek(oldpos, GEM_STREAM_START);
+		const uint8_t* view = str->GetView();
+		if (view && startpos + size <= str->Size()) {
+			memcpy(data, view + startpos, size);
+			if (!preservepos)
+				str->Seek(startpos + size, GEM_STREAM_START);
+		} else {
+			str->Seek(startpos, GEM_STREAM_START);
+			str->Read(data, size);
+			if (preservepos)
+				str->Seek(oldpos, GEM_STREAM_START);
+		}
 
 		DataStream* mem = new MemoryStream(str->originalfile.c_str(), data, size);
 		return mem;
@@ -37,6 +37,7 @@ public:
 	SlicedStream(const DataStream* cfs, strpos_t startPos, strpos_t streamSize);
 	~SlicedStream() override;
 	DataStream* Clone() const noexcept override;
+	const uint8_t* GetView() const noexcept override;
 
 	strret_t Read(void* dest, strpos_t length) override;
 	strret_t Write(const void* src, strpos_t length) override;
@@ -27,6 +27,7 @@
 #include "Animation.h"
 
 #include <array>
+#include <vector>
 
 namespace GemRB {
 
@@ -40,6 +41,20 @@ public:
 		: anim { std::make_unique<Animation>(std::move(animation)), nullptr }
 	{}
 
+	// tiles decoded on demand: the animations only keep the time, the overlay fetches frames by tileset index
+	Tile(Animation a1, std::vector<ieWord> f1, Animation a2, std::vector<ieWord> f2) noexcept
+		: Tile(std::move(a1), std::move(a2))
+	{
+		frameIndices[0] = std::move(f1);
+		frameIndices[1] = std::move(f2);
+	}
+
+	Tile(Animation animation, std::vector<ieWord> frames) noexcept
+		: Tile(std::move(animation))
+	{
+		frameIndices[0] = std::move(frames);
+	}
+
 	Tile(const Tile&) noexcept = delete;
 	Tile& operator=(const Tile& rhs) noexcept = delete;
 
@@ -48,10 +63,13 @@ public:
 
 	Animation* GetAnimation() const noexcept
 	{
-		if (anim[tileIndex]) {
-			return anim[tileIndex].get();
-		}
-		return anim[0].get();
+		return anim[GetAnimationIndex()].get();
+	}
+
+	// which animation GetAnimation returns, the second one is used by open doors
+	int GetAnimationIndex() const noexcept
+	{
+		return anim[tileIndex] ? tileIndex : 0;
 	}
 
 	Animation* GetAnimation(int idx) const noexcept
@@ -59,11 +77,18 @@ public:
 		return anim[idx].get();
 	}
 
+	// empty if the animation frames are already decoded
+	const std::vector<ieWord>& GetFrameIndices(int idx) const noexcept
+	{
+		return frameIndices[idx];
+	}
+
 	unsigned char tileIndex = 0;
 	unsigned char om = 0;
 
 private:
 	std::unique_ptr<Animation> anim[2];
+	std::vector<ieWord> frameIndices[2];
 };
 
 }
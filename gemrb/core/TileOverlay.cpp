@@ -23,18 +23,219 @@
 #include "Game.h" // for GetGlobalTint
 #include "Interface.h"
 
+#include "Plugins/TileSetMgr.h"
+
+#include <algorithm>
+
 namespace GemRB {
 
+Holder<Sprite2D> TileSpriteCache::Lookup(ieWord idx)
+{
+	auto it = index.find(idx);
+	if (it == index.end()) {
+		return nullptr;
+	}
+
+	sprites.splice(sprites.end(), sprites, it->second);
+	return it->second->second;
+}
+
+void TileSpriteCache::Add(ieWord idx, Holder<Sprite2D> sprite)
+{
+	auto it = index.find(idx);
+	if (it != index.end()) {
+		it->second->second = std::move(sprite);
+		sprites.splice(sprites.end(), sprites, it->second);
+		return;
+	}
+
+	sprites.emplace_back(idx, std::move(sprite));
+	index.emplace(idx, std::prev(sprites.end()));
+	Evict();
+}
+
+void TileSpriteCache::SetCapacity(size_t newCapacity)
+{
+	capacity = newCapacity;
+	Evict();
+}
+
+void TileSpriteCache::Evict()
+{
+	while (sprites.size() > capacity) {
+		index.erase(sprites.front().first);
+		sprites.pop_front();
+	}
+}
+
+constexpr size_t TileOverlay::CachedScreens;
+constexpr size_t TileOverlay::MinCachedTiles;
+constexpr int TileOverlay::ChunkTiles;
+constexpr int TileOverlay::ChunkSize;
+constexpr size_t TileOverlay::SpareChunks;
+
+bool TileOverlay::IsStaticTile(const Tile& tile)
+{
+	return tile.om == 0 && !tile.GetAnimation(1) && tile.GetAnimation(0)->GetFrameCount() == 1;
+}
+
 TileOverlay::TileOverlay(Size size) noexcept
 	: size(size)
 {}
 
+TileOverlay::TileOverlay(Size size, PluginHolder<TileSetMgr> tileset) noexcept
+	: size(size), tileset(std::move(tileset))
+{}
+
 void TileOverlay::AddTile(Tile&& tile)
 {
 	tiles.push_back(std::move(tile));
 }
 
-void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const
+Holder<Sprite2D> TileOverlay::GetTileSprite(ieWord index)
+{
+	Holder<Sprite2D> sprite = cache.Lookup(index);
+	if (!sprite) {
+		sprite = tileset->GetTile(index);
+		cache.Add(index, sprite);
+	}
+	return sprite;
+}
+
+Holder<Sprite2D> TileOverlay::NextFrame(const Tile& tile, int animIdx)
+{
+	Animation* anim = tile.GetAnimation(animIdx);
+	const auto& indices = tile.GetFrameIndices(animIdx);
+	if (indices.empty()) {
+		return anim->NextFrame();
+	}
+
+	// NextFrame hands out the frame from before advancing, so pick it first
+	Animation::index_t frame = anim->GetCurrentFrameIndex();
+	anim->NextFrame();
+	return GetTileSprite(indices[frame]);
+}
+
+void TileOverlay::PrefetchTile(const Tile& tile)
+{
+	for (ieWord index : tile.GetFrameIndices(tile.GetAnimationIndex())) {
+		GetTileSprite(index);
+	}
+}
+
+void TileOverlay::CompositeChunk(Chunk& chunk, const Point& chunkPos, BlitFlags flags, const Color& tint)
+{
+	if (!chunk.buffer) {
+		if (spareBuffers.empty()) {
+			chunk.buffer = VideoDriver->CreateBuffer(Region(0, 0, ChunkSize, ChunkSize));
+			stats.buffersCreated++;
+		} else {
+			chunk.buffer = std::move(spareBuffers.back());
+			spareBuffers.pop_back();
+			stats.buffersReused++;
+		}
+	}
+	stats.composited++;
+
+	chunk.buffer->Clear();
+	VideoDriver->PushDrawingBuffer(chunk.buffer);
+
+	int tx = chunkPos.x / 64;
+	int ty = chunkPos.y / 64;
+	for (int y = ty; y < ty + ChunkTiles && y < size.h; y++) {
+		for (int x = tx; x < tx + ChunkTiles && x < size.w; x++) {
+			int idx = y * size.w + x;
+			if (!staticTiles[idx]) continue;
+
+			const Tile& tile = tiles[idx];
+			const auto& indices = tile.GetFrameIndices(0);
+			Holder<Sprite2D> frame = indices.empty() ? tile.GetAnimation(0)->GetFrame(0) : GetTileSprite(indices[0]);
+			if (frame) {
+				VideoDriver->BlitGameSprite(frame, Point(x * 64, y * 64) - chunkPos, flags, tint);
+			}
+		}
+	}
+
+	VideoDriver->PopDrawingBuffer();
+	chunk.flags = flags;
+	chunk.tint = tint;
+}
+
+void TileOverlay::EvictChunks(size_t capacity)
+{
+	if (chunks.size() <= capacity) {
+		return;
+	}
+
+	std::vector<std::pair<unsigned int, int>> age;
+	age.reserve(chunks.size());
+	for (const auto& chunk : chunks) {
+		age.emplace_back(chunk.second.lastDrawn, chunk.first);
+	}
+	std::sort(age.begin(), age.end());
+
+	size_t evict = chunks.size() - capacity;
+	for (size_t i = 0; i < evict; i++) {
+		auto it = chunks.find(age[i].second);
+		// buffers are all the same size, so they can go to the next chunk
+		if (spareBuffers.size() < SpareChunks && it->second.buffer) {
+			spareBuffers.push_back(std::move(it->second.buffer));
+		}
+		chunks.erase(it);
+	}
+}
+
+void TileOverlay::DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint)
+{
+	if (staticTiles.size() != tiles.size()) {
+		staticTiles.resize(tiles.size());
+		for (size_t i = 0; i < tiles.size(); i++) {
+			staticTiles[i] = IsStaticTile(tiles[i]);
+		}
+	}
+
+	int chunkCols = (size.w + ChunkTiles - 1) / ChunkTiles;
+	int sx = std::max(viewport.x / ChunkSize, 0);
+	int sy = std::max(viewport.y / ChunkSize, 0);
+	int dx = std::min((std::max(viewport.x, 0) + viewport.w + ChunkSize - 1) / ChunkSize, chunkCols);
+	int dy = std::min((std::max(viewport.y, 0) + viewport.h + ChunkSize - 1) / ChunkSize, (size.h + ChunkTiles - 1) / ChunkTiles);
+
+	// composition happens in chunk coordinates, which the game clip knows nothing about
+	Region clip = VideoDriver->GetScreenClip();
+	bool clipChanged = false;
+
+	++drawCount;
+	for (int y = sy; y < dy; y++) {
+		for (int x = sx; x < dx; x++) {
+			Point chunkPos(x * ChunkSize, y * ChunkSize);
+			Chunk& chunk = chunks[y * chunkCols + x];
+			if (!chunk.buffer || chunk.flags != flags || chunk.tint != tint) {
+				if (!clipChanged) {
+					VideoDriver->SetScreenClip(nullptr);
+					clipChanged = true;
+				}
+				CompositeChunk(chunk, chunkPos, flags, tint);
+			}
+			chunk.lastDrawn = drawCount;
+		}
+	}
+
+	if (clipChanged) {
+		VideoDriver->SetScreenClip(&clip);
+	}
+
+	for (int y = sy; y < dy; y++) {
+		for (int x = sx; x < dx; x++) {
+			const Chunk& chunk = chunks[y * chunkCols + x];
+			VideoDriver->BlitVideoBuffer(chunk.buffer, Point(x * ChunkSize, y * ChunkSize) - viewport.origin, BlitFlags::NONE);
+		}
+	}
+
+	// the visible chunks and a ring around them
+	EvictChunks(size_t(dx - sx + 2) * size_t(dy - sy + 2));
+}
+
+void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags)
 {
 	// determine which tiles are visible
 	int sx = std::max(viewport.x / 64, 0);
@@ -50,17 +251,25 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 	}
 	const Color tintcol = globalTint ? *globalTint : Color();
 
+	// keep a few screens worth of decoded tiles, including the borders we prefetch
+	size_t visibleTiles = size_t(dx - sx + 2) * size_t(dy - sy + 2);
+	cache.SetCapacity(std::max(visibleTiles * CachedScreens, MinCachedTiles));
+
+	// static tiles are blitted as a few composited chunks, only the rest goes tile by tile
+	DrawChunks(viewport, flags, tintcol);
+
 	for (int y = sy; y < dy && y < size.h; y++) {
 		for (int x = sx; x < dx && x < size.w; x++) {
+			if (staticTiles[y * size.w + x]) continue;
+
 			const Tile& tile = tiles[(y * size.w) + x];
 
 			//draw door tiles if there are any
-			Animation* anim = tile.GetAnimation();
-			assert(anim);
+			assert(tile.GetAnimation());
 
 			// this is the base terrain tile
 			Point p = Point(x * 64, y * 64) - viewport.origin;
-			VideoDriver->BlitGameSprite(anim->NextFrame(), p, flags, tintcol);
+			VideoDriver->BlitGameSprite(NextFrame(tile, tile.GetAnimationIndex()), p, flags, tintcol);
 
 			if (!tile.om || tile.tileIndex) {
 				continue;
@@ -75,18 +284,17 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 						//draw overlay tiles, they should be half transparent except for BG1
 						BlitFlags transFlag = (core->HasFeature(GFFlags::LAYERED_WATER_TILES)) ? BlitFlags::HALFTRANS : BlitFlags::NONE;
 						// this is the water (or whatever)
-						VideoDriver->BlitGameSprite(ovtile.GetAnimation(0)->NextFrame(), p, flags | transFlag, tintcol);
+						VideoDriver->BlitGameSprite(ov->NextFrame(ovtile, 0), p, flags | transFlag, tintcol);
 
 						if (core->HasFeature(GFFlags::LAYERED_WATER_TILES)) {
-							Animation* anim1 = tile.GetAnimation(1);
-							if (anim1) {
+							if (tile.GetAnimation(1)) {
 								// this is the mask to blend the terrain tile with the water for everything but BG1
-								VideoDriver->BlitGameSprite(anim1->NextFrame(), p,
+								VideoDriver->BlitGameSprite(NextFrame(tile, 1), p,
 											    flags | BlitFlags::BLENDED, tintcol);
 							}
 						} else {
 							// in BG 1 this is the mask to blend the terrain tile with the water
-							VideoDriver->BlitGameSprite(tile.GetAnimation(0)->NextFrame(), p,
+							VideoDriver->BlitGameSprite(NextFrame(tile, 0), p,
 										    flags | BlitFlags::BLENDED, tintcol);
 						}
 					}
@@ -95,6 +303,28 @@ void TileOverlay::Draw(const Region& viewport, std::vector<TileOverlayPtr>& over
 			}
 		}
 	}
+
+	// decode the row and column about to scroll into view
+	Point scroll = viewport.origin - lastOrigin;
+	lastOrigin = viewport.origin;
+	if (!tileset) {
+		return;
+	}
+
+	int ex = std::min(dx, size.w);
+	int ey = std::min(dy, size.h);
+	if (scroll.x) {
+		int x = scroll.x > 0 ? dx : sx - 1;
+		for (int y = sy; x >= 0 && x < size.w && y < ey; y++) {
+			PrefetchTile(tiles[y * size.w + x]);
+		}
+	}
+	if (scroll.y) {
+		int y = scroll.y > 0 ? dy : sy - 1;
+		for (int x = sx; y >= 0 && y < size.h && x < ex; x++) {
+			PrefetchTile(tiles[y * size.w + x]);
+		}
+	}
 }
 
 }
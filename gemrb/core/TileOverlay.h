@@ -23,12 +23,41 @@
 
 #include "exports.h"
 
+#include "Plugin.h"
 #include "Tile.h"
 
+#include "Video/Video.h"
+
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace GemRB {
 
+class TileSetMgr;
+
+/* Decoded tile sprites by tileset index, the least recently used ones are dropped over the capacity. */
+class GEM_EXPORT TileSpriteCache {
+public:
+	explicit TileSpriteCache(size_t capacity) noexcept
+		: capacity(capacity) {}
+
+	Holder<Sprite2D> Lookup(ieWord index);
+	void Add(ieWord index, Holder<Sprite2D> sprite);
+	void SetCapacity(size_t capacity);
+	size_t GetCapacity() const { return capacity; }
+	size_t Size() const { return sprites.size(); }
+
+private:
+	using entry_t = std::pair<ieWord, Holder<Sprite2D>>;
+	// front is the least recently used
+	std::list<entry_t> sprites;
+	std::unordered_map<ieWord, std::list<entry_t>::iterator> index;
+	size_t capacity;
+
+	void Evict();
+};
+
 class GEM_EXPORT TileOverlay {
 public:
 	Size size;
@@ -37,7 +66,15 @@ public:
 public:
 	using TileOverlayPtr = Holder<TileOverlay>;
 
+	struct Stats {
+		size_t composited = 0;
+		size_t buffersCreated = 0;
+		size_t buffersReused = 0;
+	};
+
 	explicit TileOverlay(Size size) noexcept;
+	// tiles with frame indices get their frames decoded from the tileset when they are drawn
+	TileOverlay(Size size, PluginHolder<TileSetMgr> tileset) noexcept;
 	TileOverlay(const TileOverlay&) noexcept = delete;
 	TileOverlay& operator=(const TileOverlay&) noexcept = delete;
 
@@ -45,7 +82,48 @@ public:
 	TileOverlay& operator=(TileOverlay&&) noexcept = default;
 
 	void AddTile(Tile&& tile);
-	void Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags) const;
+	void Draw(const Region& viewport, std::vector<TileOverlayPtr>& overlays, BlitFlags flags);
+	const Stats& GetStats() const { return stats; }
+
+	// animated, door and water tiles change, so they are drawn every frame instead of composited
+	static bool IsStaticTile(const Tile& tile);
+
+private:
+	// the cache holds this many screens worth of tiles
+	static constexpr size_t CachedScreens = 3;
+	static constexpr size_t MinCachedTiles = 256;
+	// static tiles are composited in chunks of this many tiles per side,
+	// small enough to fit the screen clip of any supported resolution
+	static constexpr int ChunkTiles = 4;
+	static constexpr int ChunkSize = ChunkTiles * 64;
+	// buffers of evicted chunks kept for reuse
+	static constexpr size_t SpareChunks = 8;
+
+	struct Chunk {
+		VideoBufferPtr buffer;
+		// what the tiles were composited with
+		BlitFlags flags = BlitFlags::NONE;
+		Color tint;
+		unsigned int lastDrawn = 0;
+	};
+
+	PluginHolder<TileSetMgr> tileset;
+	TileSpriteCache cache { MinCachedTiles };
+	Point lastOrigin;
+
+	std::vector<bool> staticTiles;
+	std::unordered_map<int, Chunk> chunks;
+	std::vector<VideoBufferPtr> spareBuffers;
+	unsigned int drawCount = 0;
+	Stats stats;
+
+	Holder<Sprite2D> NextFrame(const Tile& tile, int animIdx);
+	Holder<Sprite2D> GetTileSprite(ieWord index);
+	void PrefetchTile(const Tile& tile);
+
+	void DrawChunks(const Region& viewport, BlitFlags flags, const Color& tint);
+	void CompositeChunk(Chunk& chunk, const Point& chunkPos, BlitFlags flags, const Color& tint);
+	void EvictChunks(size_t capacity);
 };
 
 }
@@ -50,7 +50,7 @@ inline uint8_t* DecodeRLEData(const uint8_t* p, const Size& size, colorkey_t col
 	return buffer;
 }
 
-inline uint8_t* FindRLEPos(uint8_t* rledata, int pitch, const Point& p, colorkey_t ck)
+inline const uint8_t* FindRLEPos(const uint8_t* rledata, int pitch, const Point& p, colorkey_t ck)
 {
 	int skipcount = p.y * pitch + p.x;
 	while (skipcount > 0) {
@@ -63,6 +63,11 @@ inline uint8_t* FindRLEPos(uint8_t* rledata, int pitch, const Point& p, colorkey
 	return rledata;
 }
 
+inline uint8_t* FindRLEPos(uint8_t* rledata, int pitch, const Point& p, colorkey_t ck)
+{
+	return const_cast<uint8_t*>(FindRLEPos(static_cast<const uint8_t*>(rledata), pitch, p, ck));
+}
+
 class RLEIterator : public PixelIterator<uint8_t> {
 	uint8_t* dataPos = nullptr;
 	colorkey_t colorkey = 0;
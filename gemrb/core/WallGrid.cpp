@@ -0,0 +1,126 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "WallGrid.h"
+
+#include "globals.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace GemRB {
+
+WallGrid::WallGrid(const std::vector<WallPolygonGroup>& wallGroups)
+{
+	// the wall groups overlap, so the same polygon is usually listed several times
+	std::unordered_set<const WallPolygon*> seen;
+	Point extent;
+	for (const auto& group : wallGroups) {
+		for (const auto& wp : group) {
+			if (!wp || !seen.insert(wp.get()).second) continue;
+
+			walls.push_back(wp);
+			extent.x = std::max(extent.x, wp->BBox.x + wp->BBox.w);
+			extent.y = std::max(extent.y, wp->BBox.y + wp->BBox.h);
+		}
+	}
+	if (walls.empty()) return;
+
+	gridSize.w = std::max(1, (extent.x + CELL_SIZE - 1) / CELL_SIZE);
+	gridSize.h = std::max(1, (extent.y + CELL_SIZE - 1) / CELL_SIZE);
+
+	// count first, then fill, so all the cells share one flat array
+	std::vector<uint32_t> counts(gridSize.Area() + 1);
+	auto forEachCell = [this](const Region& bbox, auto&& callback) {
+		int x1 = CellX(bbox.x + bbox.w - 1);
+		int y1 = CellY(bbox.y + bbox.h - 1);
+		for (int y = CellY(bbox.y); y <= y1; ++y) {
+			for (int x = CellX(bbox.x); x <= x1; ++x) {
+				callback(y * gridSize.w + x);
+			}
+		}
+	};
+	for (const auto& wp : walls) {
+		forEachCell(wp->BBox, [&counts](int cell) { counts[cell + 1]++; });
+	}
+	for (size_t i = 1; i < counts.size(); ++i) {
+		counts[i] += counts[i - 1];
+	}
+	cellStart = counts;
+	cellWalls.resize(counts.back());
+	for (uint32_t idx = 0; idx < walls.size(); ++idx) {
+		forEachCell(walls[idx]->BBox, [&](int cell) { cellWalls[counts[cell]++] = idx; });
+	}
+
+	marks.resize(walls.size());
+}
+
+int WallGrid::CellX(int x) const noexcept
+{
+	return Clamp(x / CELL_SIZE, 0, gridSize.w - 1);
+}
+
+int WallGrid::CellY(int y) const noexcept
+{
+	return Clamp(y / CELL_SIZE, 0, gridSize.h - 1);
+}
+
+void WallGrid::Query(const Region& rgn, WallPolygonSet& set, bool includeDisabled, const Point* loc) const
+{
+	set.first.clear();
+	set.second.clear();
+	if (walls.empty()) return;
+
+	if (++mark == 0) {
+		std::fill(marks.begin(), marks.end(), 0);
+		mark = 1;
+	}
+
+	hits.clear();
+	int x1 = CellX(rgn.x + rgn.w - 1);
+	int y1 = CellY(rgn.y + rgn.h - 1);
+	for (int y = CellY(rgn.y); y <= y1; ++y) {
+		for (int x = CellX(rgn.x); x <= x1; ++x) {
+			int cell = y * gridSize.w + x;
+			for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+				uint32_t idx = cellWalls[i];
+				if (marks[idx] == mark) continue;
+				marks[idx] = mark;
+
+				const WallPolygon& wp = *walls[idx];
+				if ((wp.wallFlag & WF_DISABLED) && !includeDisabled) continue;
+				if (!rgn.IntersectsRegion(wp.BBox)) continue;
+				hits.push_back(idx);
+			}
+		}
+	}
+	std::sort(hits.begin(), hits.end());
+
+	for (uint32_t idx : hits) {
+		const auto& wp = walls[idx];
+		if (loc == nullptr || wp->PointBehind(*loc)) {
+			set.first.push_back(wp);
+		} else {
+			set.second.push_back(wp);
+		}
+	}
+}
+
+}
@@ -0,0 +1,64 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef WALLGRID_H
+#define WALLGRID_H
+
+#include "exports.h"
+
+#include "Polygon.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace GemRB {
+
+// Uniform grid over the bounding boxes of the wall polygons of a map. It is
+// finer than the 640x480 wall groups from the WED and lists every polygon
+// only once, so stencil and occlusion queries only test nearby walls.
+class GEM_EXPORT WallGrid {
+public:
+	static constexpr int CELL_SIZE = 128; // in map pixels
+
+	WallGrid() noexcept = default;
+	explicit WallGrid(const std::vector<WallPolygonGroup>& wallGroups);
+
+	// clears set and fills it with the walls intersecting rgn, in their original order;
+	// with loc, the walls it is behind go into the first half and the rest into the second
+	void Query(const Region& rgn, WallPolygonSet& set, bool includeDisabled, const Point* loc) const;
+
+private:
+	Size gridSize;
+	WallPolygonGroup walls;
+	// walls of cell i are cellWalls[cellStart[i]] up to cellWalls[cellStart[i + 1]]
+	std::vector<uint32_t> cellStart;
+	std::vector<uint32_t> cellWalls;
+	// per query stamps, so walls spanning several cells are only reported once
+	mutable std::vector<uint32_t> marks;
+	mutable uint32_t mark = 0;
+	mutable std::vector<uint32_t> hits;
+
+	int CellX(int x) const noexcept;
+	int CellY(int y) const noexcept;
+};
+
+}
+
+#endif
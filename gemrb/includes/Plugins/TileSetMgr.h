@@ -32,8 +32,10 @@ namespace GemRB {
 class GEM_PLUGIN_EXPORT TileSetMgr : public Plugin {
 public:
 	virtual bool Open(DataStream* stream) = 0;
+	/** Returns a tile referring to the tileset frames, they are only decoded on demand by GetTile(index). */
 	virtual Tile* GetTile(const std::vector<ieWord>& indexes,
 			      unsigned short* secondary = NULL) = 0;
+	virtual Holder<Sprite2D> GetTile(int index) = 0;
 };
 
 }
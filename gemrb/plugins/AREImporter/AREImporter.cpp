@@ -1440,12 +1440,59 @@ void AREImporter::GetTile(DataStream* str, Map* map) const
 	map->TMap->AddTile(tileID, tileName, tileFlags, nullptr, 0, nullptr, 0);
 }
 
+// let the disk work while we parse: queue what the rest of GetMap will ask for
+void AREImporter::PrefetchResources(DataStream* str, bool day_or_night) const
+{
+	ResourceManager::PrefetchList resources;
+	ResRef tmpResRef;
+
+	resources.emplace_back(WEDResRef, IE_TIS_CLASS_ID);
+	if (day_or_night) {
+		resources.emplace_back(WEDResRef, IE_MOS_CLASS_ID);
+		tmpResRef.Format("{:.6}LM", WEDResRef);
+	} else {
+		tmpResRef.Format("{:.7}N", WEDResRef);
+		resources.emplace_back(tmpResRef, IE_MOS_CLASS_ID);
+		tmpResRef.Format("{:.6}LN", WEDResRef);
+	}
+	resources.emplace_back(tmpResRef, IE_BMP_CLASS_ID);
+	tmpResRef.Format("{:.6}SR", WEDResRef);
+	resources.emplace_back(tmpResRef, IE_BMP_CLASS_ID);
+	tmpResRef.Format("{:.6}HT", WEDResRef);
+	resources.emplace_back(tmpResRef, IE_BMP_CLASS_ID);
+
+	// see GetActor for the layout
+	ieDword flags;
+	ieDword creOffset;
+	for (int i = 0; i < ActorCount; i++) {
+		str->Seek(ActorOffset + i * 0x110 + 0x28, GEM_STREAM_START);
+		str->ReadDword(flags);
+		str->Seek(ActorOffset + i * 0x110 + 0x80, GEM_STREAM_START);
+		str->ReadResRef(tmpResRef);
+		str->ReadDword(creOffset);
+		if (creOffset == 0 || (flags & AF_CRE_NOT_LOADED)) {
+			resources.emplace_back(tmpResRef, IE_CRE_CLASS_ID);
+		}
+	}
+
+	// see GetAreaAnimation
+	for (ieDword i = 0; i < AnimCount; i++) {
+		str->Seek(AnimOffset + i * 0x4c + 0x28, GEM_STREAM_START);
+		str->ReadResRef(tmpResRef);
+		resources.emplace_back(tmpResRef, IE_BAM_CLASS_ID);
+	}
+
+	gamedata->Prefetch(resources);
+}
+
 Map* AREImporter::GetMap(const ResRef& resRef, bool day_or_night)
 {
 	// if this area does not have extended night, force it to day mode
 	if (!(AreaFlags & AT_EXTENDED_NIGHT))
 		day_or_night = true;
 
+	PrefetchResources(str, day_or_night);
+
 	PluginHolder<TileMapMgr> tmm = MakePluginHolder<TileMapMgr>(IE_WED_CLASS_ID);
 	DataStream* wedfile = gamedata->GetResourceStream(WEDResRef, IE_WED_CLASS_ID);
 	tmm->Open(wedfile);
@@ -96,6 +96,7 @@ private:
 	int PutRestHeader(DataStream* stream, const Map* map) const;
 	int PutMapAmbients(DataStream* stream, const Map* map) const;
 
+	void PrefetchResources(DataStream* str, bool day_or_night) const;
 	void GetSongs(DataStream* str, Map* map, std::vector<Ambient*>& ambients) const;
 	void GetRestHeader(DataStream* str, Map* map) const;
 	void GetInfoPoint(DataStream* str, int idx, Map* map) const;
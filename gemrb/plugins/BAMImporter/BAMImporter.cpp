@@ -31,6 +31,8 @@
 #include "Video/RLE.h"
 #include "Video/Video.h"
 
+#include <unordered_map>
+
 using namespace GemRB;
 
 bool BAMImporter::Import(DataStream* str)
@@ -149,11 +151,11 @@ BAMImporter::index_t BAMImporter::GetCycleSize(index_t cycle)
 	return cycles[cycle].FramesCount;
 }
 
-Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool RLESprite, uint8_t* data) const
+Holder<Sprite2D> BAMImporter::GetFrameInternal(const FrameEntry& frameInfo, bool RLESprite, const uint8_t* data) const
 {
 	Holder<Sprite2D> spr;
 	const Region& rgn = frameInfo.bounds;
-	uint8_t* dataBegin = data + frameInfo.location.dataOffset;
+	const uint8_t* dataBegin = data + frameInfo.location.dataOffset;
 
 	if (RLESprite) {
 		PixelFormat fmt = PixelFormat::RLE8Bit(palette, CompressedColorIndex);
@@ -261,14 +263,31 @@ std::shared_ptr<AnimationFactory> BAMImporter::GetAnimationFactory(const ResRef&
 		if (length == 0) return nullptr;
 
 		auto FLT = CacheFLT();
-		uint8_t* data = (uint8_t*) malloc(length);
-		str->Read(data, length);
+		// parse in place if the data is already in memory
+		const uint8_t* view = str->GetView();
+		uint8_t* copy = nullptr;
+		if (view) {
+			view += DataStart;
+		} else {
+			copy = (uint8_t*) malloc(length);
+			str->Read(copy, length);
+			view = copy;
+		}
 
+		// several frame entries can point to the same data, decode and keep it only once
+		std::unordered_map<strpos_t, size_t> decoded;
 		for (const auto& frameInfo : frames) {
+			auto same = decoded.find(frameInfo.location.dataOffset);
+			if (same != decoded.end() && frames[same->second].bounds == frameInfo.bounds && frames[same->second].RLE == frameInfo.RLE) {
+				animframes.push_back(animframes[same->second]);
+				continue;
+			}
+			decoded.emplace(frameInfo.location.dataOffset, animframes.size());
+
 			bool RLECompressed = allowCompression && frameInfo.RLE;
-			animframes.push_back(GetFrameInternal(frameInfo, RLECompressed, data - DataStart));
+			animframes.push_back(GetFrameInternal(frameInfo, RLECompressed, view - DataStart));
 		}
-		free(data);
+		free(copy);
 
 		return std::make_shared<AnimationFactory>(resref, std::move(animframes), cycles, std::move(FLT));
 	} else {
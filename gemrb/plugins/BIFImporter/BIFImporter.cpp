@@ -156,25 +156,48 @@ int BIFImporter::OpenArchive(const path_t& path)
 DataStream* BIFImporter::GetStream(unsigned long Resource, unsigned long Type)
 {
 	if (Type == IE_TIS_CLASS_ID) {
-		unsigned int srcResLoc = Resource & 0xFC000;
-		for (unsigned int i = 0; i < tentcount; i++) {
-			if ((tentries[i].resLocator & 0xFC000) == srcResLoc) {
-				return SliceStream(stream, tentries[i].dataOffset,
-						   tentries[i].tileSize * tentries[i].tilesCount);
-			}
+		size_t idx = (Resource & 0xFC000) >> 14;
+		if (idx < tileIndex.size() && tileIndex[idx]) {
+			const TileEntry* entry = tileIndex[idx];
+			return SliceStream(stream, entry->dataOffset, entry->tileSize * entry->tilesCount);
 		}
 	} else {
-		ieDword srcResLoc = Resource & 0x3FFF;
-		for (ieDword i = 0; i < fentcount; i++) {
-			if ((fentries[i].resLocator & 0x3FFF) == srcResLoc) {
-				return SliceStream(stream, fentries[i].dataOffset,
-						   fentries[i].fileSize);
-			}
+		size_t idx = Resource & 0x3FFF;
+		if (idx < fileIndex.size() && fileIndex[idx]) {
+			const FileEntry* entry = fileIndex[idx];
+			return SliceStream(stream, entry->dataOffset, entry->fileSize);
 		}
 	}
 	return NULL;
 }
 
+void BIFImporter::IndexEntries()
+{
+	// the locators are (nearly) sequential, so a direct table stays small
+	// if several entries share a locator, the first one wins, as with the old linear search
+	fileIndex.clear();
+	for (ieDword i = 0; i < fentcount; i++) {
+		size_t idx = fentries[i].resLocator & 0x3FFF;
+		if (idx >= fileIndex.size()) {
+			fileIndex.resize(idx + 1, nullptr);
+		}
+		if (!fileIndex[idx]) {
+			fileIndex[idx] = &fentries[i];
+		}
+	}
+
+	tileIndex.clear();
+	for (ieDword i = 0; i < tentcount; i++) {
+		size_t idx = (tentries[i].resLocator & 0xFC000) >> 14;
+		if (idx >= tileIndex.size()) {
+			tileIndex.resize(idx + 1, nullptr);
+		}
+		if (!tileIndex[idx]) {
+			tileIndex[idx] = &tentries[i];
+		}
+	}
+}
+
 int BIFImporter::ReadBIF()
 {
 	ieDword foffset;
@@ -205,6 +228,7 @@ int BIFImporter::ReadBIF()
 		stream->ReadWord(tentries[i].type);
 		stream->ReadWord(tentries[i].u1);
 	}
+	IndexEntries();
 	return GEM_OK;
 }
 
@@ -24,6 +24,8 @@
 #include "Plugins/IndexedArchive.h"
 #include "Streams/DataStream.h"
 
+#include <vector>
+
 namespace GemRB {
 
 struct FileEntry {
@@ -50,6 +52,9 @@ private:
 	ieDword fentcount = 0;
 	ieDword tentcount = 0;
 	DataStream* stream = nullptr;
+	// entries by their locator index (resLocator & 0x3FFF for files, bits 14-19 for tilesets)
+	std::vector<const FileEntry*> fileIndex;
+	std::vector<const TileEntry*> tileIndex;
 
 public:
 	BIFImporter() noexcept = default;
@@ -63,6 +68,7 @@ private:
 	static DataStream* DecompressBIF(DataStream* compressed, const path_t& path);
 	static DataStream* DecompressBIFC(DataStream* compressed, const path_t& path);
 	int ReadBIF();
+	void IndexEntries();
 };
 
 }
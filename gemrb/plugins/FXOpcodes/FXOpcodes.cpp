@@ -457,7 +457,7 @@ int fx_unknown(Scriptable* Owner, Actor* target, Effect* fx); //???
 
 static EffectDesc effectnames[] = {
 	EffectDesc("*Crash*", fx_crash, EFFECT_NO_ACTOR, -1),
-	EffectDesc("AcidResistanceModifier", fx_acid_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("AcidResistanceModifier", fx_acid_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTACID),
 	EffectDesc("ACVsCreatureType", fx_generic_effect, 0, -1), //0xdb
 	EffectDesc("ACVsDamageTypeModifier", fx_ac_vs_damage_type_modifier, 0, -1),
 	EffectDesc("ACVsDamageTypeModifier2", fx_ac_vs_damage_type_modifier, 0, -1), // used in IWD
@@ -518,7 +518,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("ChaosShieldModifier", fx_chaos_shield_modifier, 0, -1),
 	EffectDesc("CharismaModifier", fx_charisma_modifier, EFFECT_SPECIAL_UNDO, -1),
 	EffectDesc("CheckForBerserkModifier", fx_checkforberserk_modifier, 0, -1),
-	EffectDesc("ColdResistanceModifier", fx_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("ColdResistanceModifier", fx_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTCOLD),
 	EffectDesc("Color:BriefRGB", fx_brief_rgb, 0, -1),
 	EffectDesc("Color:GlowRGB", fx_glow_rgb, 0, -1),
 	EffectDesc("Color:DarkenRGB", fx_darken_rgb, 0, -1),
@@ -532,7 +532,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("CreateContingency", fx_create_contingency, 0, -1),
 	EffectDesc("CriticalHitModifier", fx_critical_hit_modifier, 0, -1),
 	EffectDesc("CriticalMissModifier", fx_generic_effect, 0, -1),
-	EffectDesc("CrushingResistanceModifier", fx_crushing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("CrushingResistanceModifier", fx_crushing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTCRUSHING),
 	EffectDesc("Cure:Berserk", fx_cure_berserk_state, 0, -1),
 	EffectDesc("Cure:Blind", fx_cure_blind_state, 0, -1),
 	EffectDesc("Cure:CasterHold", fx_unpause_caster, 0, -1),
@@ -590,7 +590,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("DrainItems", fx_drain_items, 0, -1),
 	EffectDesc("DrainSpells", fx_drain_spells, 0, -1),
 	EffectDesc("DropWeapon", fx_drop_weapon, 0, -1),
-	EffectDesc("ElectricityResistanceModifier", fx_electricity_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("ElectricityResistanceModifier", fx_electricity_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTELECTRICITY),
 	EffectDesc("EnchantmentBonus", fx_generic_effect, 0, -1),
 	EffectDesc("EnchantmentVsCreatureType", fx_generic_effect, 0, -1),
 	EffectDesc("ExistanceDelayModifier", fx_existence_delay_modifier, 0, -1),
@@ -603,7 +603,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("FindFamiliar", fx_find_familiar, 0, -1),
 	EffectDesc("FindTraps", fx_find_traps, 0, -1),
 	EffectDesc("FindTrapsModifier", fx_find_traps_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("FireResistanceModifier", fx_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("FireResistanceModifier", fx_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTFIRE),
 	EffectDesc("FistDamageModifier", fx_fist_damage_modifier, 0, -1),
 	EffectDesc("FistHitModifier", fx_fist_to_hit_modifier, 0, -1),
 	EffectDesc("FloatText", fx_floattext, 0, -1),
@@ -636,15 +636,15 @@ static EffectDesc effectnames[] = {
 	EffectDesc("KillCreatureType", fx_kill_creature_type, 0, -1),
 	EffectDesc("LevelModifier", fx_level_modifier, 0, -1),
 	EffectDesc("LevelDrainModifier", fx_leveldrain_modifier, 0, -1),
-	EffectDesc("LoreModifier", fx_lore_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("LuckModifier", fx_luck_modifier, EFFECT_NO_LEVEL_CHECK | EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("LoreModifier", fx_lore_modifier, EFFECT_SPECIAL_UNDO, -1, IE_LORE),
+	EffectDesc("LuckModifier", fx_luck_modifier, EFFECT_NO_LEVEL_CHECK | EFFECT_SPECIAL_UNDO, -1, IE_LUCK),
 	EffectDesc("LuckCumulative", fx_luck_cumulative, 0, -1),
 	EffectDesc("LuckNonCumulative", fx_luck_non_cumulative, 0, -1),
-	EffectDesc("MagicalColdResistanceModifier", fx_magical_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("MagicalFireResistanceModifier", fx_magical_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("MagicalColdResistanceModifier", fx_magical_cold_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTMAGICCOLD),
+	EffectDesc("MagicalFireResistanceModifier", fx_magical_fire_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTMAGICFIRE),
 	EffectDesc("MagicalRest", fx_magical_rest, 0, -1),
-	EffectDesc("MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, 0, -1),
-	EffectDesc("MagicResistanceModifier", fx_magic_resistance_modifier, 0, -1),
+	EffectDesc("MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, 0, -1, IE_MAGICDAMAGERESISTANCE),
+	EffectDesc("MagicResistanceModifier", fx_magic_resistance_modifier, 0, -1, IE_RESISTMAGIC),
 	EffectDesc("MakeUnselectable", fx_crash, 0, -1),
 	EffectDesc("MassRaiseDead", fx_mass_raise_dead, EFFECT_NO_ACTOR, -1),
 	EffectDesc("MaximumHPModifier", fx_maximum_hp_modifier, EFFECT_DICED | EFFECT_SPECIAL_UNDO, -1),
@@ -683,11 +683,11 @@ static EffectDesc effectnames[] = {
 	EffectDesc("Overlay:Web", fx_set_web_state, 0, -1),
 	EffectDesc("PauseTarget", fx_pause_target, 0, -1), //also known as casterhold
 	EffectDesc("PickPocketsModifier", fx_pick_pockets_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("PiercingResistanceModifier", fx_piercing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("PiercingResistanceModifier", fx_piercing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTPIERCING),
 	EffectDesc("PlayMovie", fx_play_movie, EFFECT_NO_ACTOR, -1),
 	EffectDesc("PlaySound", fx_playsound, EFFECT_NO_ACTOR, -1),
 	EffectDesc("PlayVisualEffect", fx_play_visual_effect, EFFECT_REINIT_ON_LOAD, -1),
-	EffectDesc("PoisonResistanceModifier", fx_poison_resistance_modifier, 0, -1),
+	EffectDesc("PoisonResistanceModifier", fx_poison_resistance_modifier, 0, -1, IE_RESISTPOISON),
 	EffectDesc("Polymorph", fx_polymorph, 0, -1),
 	EffectDesc("PortraitChange", fx_portrait_change, 0, -1),
 	EffectDesc("PowerWordKill", fx_power_word_kill, 0, -1),
@@ -735,12 +735,12 @@ static EffectDesc effectnames[] = {
 	EffectDesc("RetreatFrom2", fx_turn_undead, 0, -1),
 	EffectDesc("RightHitModifier", fx_right_to_hit_modifier, 0, -1),
 	EffectDesc("SaveBonus", fx_save_bonus, 0, -1),
-	EffectDesc("SaveVsBreathModifier", fx_save_vs_breath_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsDeathModifier", fx_save_vs_death_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsPolyModifier", fx_save_vs_poly_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("SaveVsBreathModifier", fx_save_vs_breath_modifier, EFFECT_SPECIAL_UNDO, -1, IE_SAVEVSBREATH),
+	EffectDesc("SaveVsDeathModifier", fx_save_vs_death_modifier, EFFECT_SPECIAL_UNDO, -1, IE_SAVEVSDEATH),
+	EffectDesc("SaveVsPolyModifier", fx_save_vs_poly_modifier, EFFECT_SPECIAL_UNDO, -1, IE_SAVEVSPOLY),
 	EffectDesc("SaveVsSchoolModifier", fx_generic_effect, 0, -1),
-	EffectDesc("SaveVsSpellsModifier", fx_save_vs_spell_modifier, EFFECT_SPECIAL_UNDO, -1),
-	EffectDesc("SaveVsWandsModifier", fx_save_vs_wands_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("SaveVsSpellsModifier", fx_save_vs_spell_modifier, EFFECT_SPECIAL_UNDO, -1, IE_SAVEVSSPELL),
+	EffectDesc("SaveVsWandsModifier", fx_save_vs_wands_modifier, EFFECT_SPECIAL_UNDO, -1, IE_SAVEVSWANDS),
 	EffectDesc("ScreenShake", fx_screenshake, EFFECT_NO_ACTOR, -1),
 	EffectDesc("ScriptingState", fx_scripting_state, 0, -1),
 	EffectDesc("Sequencer:Activate", fx_activate_spell_sequencer, EFFECT_PRESET_TARGET, -1),
@@ -755,7 +755,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("SetTrapsModifier", fx_set_traps_modifier, 0, -1),
 	EffectDesc("SevenEyes", fx_seven_eyes, 0, -1),
 	EffectDesc("SexModifier", fx_sex_modifier, 0, -1),
-	EffectDesc("SlashingResistanceModifier", fx_slashing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1),
+	EffectDesc("SlashingResistanceModifier", fx_slashing_resistance_modifier, EFFECT_SPECIAL_UNDO, -1, IE_RESISTSLASHING),
 	EffectDesc("SlowPoison", fx_slow_poison, 0, -1),
 	EffectDesc("Sparkle", fx_sparkle, 0, -1),
 	EffectDesc("SpellDurationModifier", fx_spell_duration_modifier, 0, -1),
@@ -800,7 +800,7 @@ static EffectDesc effectnames[] = {
 	EffectDesc("State:Slowed", fx_set_slowed_state, 0, -1),
 	EffectDesc("State:Stun", fx_set_stun_state, 0, -1),
 	EffectDesc("StaticCharge", fx_static_charge, EFFECT_NO_LEVEL_CHECK, -1),
-	EffectDesc("StealthModifier", fx_stealth_modifier, 0, -1),
+	EffectDesc("StealthModifier", fx_stealth_modifier, 0, -1, IE_STEALTH),
 	EffectDesc("StoneSkinModifier", fx_stoneskin_modifier, 0, -1),
 	EffectDesc("StoneSkin2Modifier", fx_golem_stoneskin_modifier, 0, -1),
 	EffectDesc("StrengthModifier", fx_strength_modifier, EFFECT_SPECIAL_UNDO, -1),
@@ -9525,6 +9525,59 @@ static PyObject* GemRB_IsDraggingItem(PyObject* /*self*/, PyObject* /*args*/)
 	return PyBool_FromLong(core->GetDraggedItem() != NULL);
 }
 
+PyDoc_STRVAR(GemRB_GetFactoryStats__doc,
+	     "===== GetFactoryStats =====\n\
+\n\
+**Prototype:** GemRB.GetFactoryStats ()\n\
+\n\
+**Description:** Returns the state of the cache of loaded animations and images. \
+Objects are evicted least recently used first once the cache grows over its budget, \
+except for those still in use elsewhere.\n\
+\n\
+**Parameters:** N/A\n\
+\n\
+**Return value:** dict with the 'Objects', 'Used' and 'Budget' (in bytes), 'Hits', \
+'Misses' and 'Evictions' keys\n\
+\n\
+**See also:** [GetFunctionStats](GetFunctionStats.md)\n\
+");
+
+static PyObject* GemRB_GetFactoryStats(PyObject* /*self*/, PyObject* /*args*/)
+{
+	const auto& stats = gamedata->GetFactoryStats();
+	return Py_BuildValue("{s:k,s:k,s:k,s:k,s:k,s:k}", "Objects", static_cast<unsigned long>(stats.objects),
+			     "Used", static_cast<unsigned long>(stats.used), "Budget", static_cast<unsigned long>(stats.budget),
+			     "Hits", static_cast<unsigned long>(stats.hits), "Misses", static_cast<unsigned long>(stats.misses),
+			     "Evictions", static_cast<unsigned long>(stats.evictions));
+}
+
+PyDoc_STRVAR(GemRB_GetFunctionStats__doc,
+	     "===== GetFunctionStats =====\n\
+\n\
+**Prototype:** GemRB.GetFunctionStats ()\n\
+\n\
+**Description:** Returns how often the engine called each GUIScript function \
+and how long those calls took in total. Useful for finding slow scripts. \
+The times include any script functions called in turn.\n\
+\n\
+**Parameters:** N/A\n\
+\n\
+**Return value:** dict of 'module.function' keys and (calls, microseconds) tuples\n\
+\n\
+**See also:** [GetSystemVariable](GetSystemVariable.md)\n\
+");
+
+static PyObject* GemRB_GetFunctionStats(PyObject* /*self*/, PyObject* /*args*/)
+{
+	PyObject* dict = PyDict_New();
+	for (const auto& entry : gs->GetFunctionStats()) {
+		PyObject* stats = Py_BuildValue("(kL)", entry.second.calls, static_cast<long long>(entry.second.time.count()));
+		PyDict_SetItemString(dict, entry.first.c_str(), stats);
+		Py_DECREF(stats);
+	}
+	return dict;
+}
+
 PyDoc_STRVAR(GemRB_GetSystemVariable__doc,
 	     "===== GetSystemVariable =====\n\
 \n\
@@ -12749,6 +12802,8 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetEffects, METH_VARARGS),
 	METHOD(GetEquippedAmmunition, METH_VARARGS),
 	METHOD(GetEquippedQuickSlot, METH_VARARGS),
+	METHOD(GetFactoryStats, METH_NOARGS),
+	METHOD(GetFunctionStats, METH_NOARGS),
 	METHOD(GetGamePreview, METH_VARARGS),
 	METHOD(GetGameString, METH_VARARGS),
 	METHOD(GetGameTime, METH_NOARGS),
@@ -12967,6 +13022,7 @@ GUIScript::GUIScript(void)
 GUIScript::~GUIScript(void)
 {
 	if (Py_IsInitialized()) {
+		ClearFunctionCache();
 		if (pModule) {
 			Py_DECREF(pModule);
 		}
@@ -13155,6 +13211,7 @@ bool GUIScript::LoadScript(const std::string& filename)
 		return false;
 	}
 
+	ClearFunctionCache();
 	if (pModule) {
 		Py_DECREF(pModule);
 	}
@@ -13203,7 +13260,9 @@ static PyObject* ParamToPython(const GUIScript::Parameter& p)
 		const View* view = p.Value<View*>();
 		return gs->ConstructObjectForScriptable(view->GetScriptingRef());
 	} else if (type == typeid(PyObject*)) {
-		return p.Value<PyObject*>();
+		PyObject* obj = p.Value<PyObject*>();
+		Py_INCREF(obj); // all the other branches return new references too
+		return obj;
 	} else {
 		Log(ERROR, "GUIScript", "Unknown parameter type: %s", type.name());
 		// need to insert a None placeholder so remaining parameters are correct
@@ -13248,9 +13307,8 @@ PyObject* GUIScript::RunPyFunction(const char* Modulename, const char* FunctionN
 		auto pyParams = DecRef(PyTuple_New, size);
 
 		for (size_t i = 0; i < size; ++i) {
-			PyObject* pyParam = ParamToPython(params[i]); // a "stolen" reference for PyTuple_SetItem
-			Py_INCREF(pyParam); // could depend on Python version, see #2198
-			PyTuple_SetItem(pyParams, i, pyParam);
+			// ParamToPython always hands out a new reference, which the tuple steals
+			PyTuple_SET_ITEM(static_cast<PyObject*>(pyParams), i, ParamToPython(params[i]));
 		}
 		return RunPyFunction(Modulename, FunctionName, pyParams, report_error);
 	} else {
@@ -13258,10 +13316,14 @@ PyObject* GUIScript::RunPyFunction(const char* Modulename, const char* FunctionN
 	}
 }
 
-PyObject* GUIScript::RunPyFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+GUIScript::CachedFunction* GUIScript::ResolveFunction(const char* moduleName, const char* functionName)
 {
-	if (!Py_IsInitialized()) {
-		return NULL;
+	functionKey.assign(moduleName ? moduleName : "");
+	functionKey.append(1, '.').append(functionName);
+
+	auto lookup = functionCache.find(functionKey);
+	if (lookup != functionCache.end()) {
+		return &lookup->second;
 	}
 
 	PyObject* pyModule;
@@ -13273,31 +13335,82 @@ PyObject* GUIScript::RunPyFunction(const char* moduleName, const char* functionN
 	}
 	if (!pyModule) {
 		PyErr_Print();
+		return nullptr;
+	}
+
+	CachedFunction& entry = functionCache[functionKey];
+	entry.module = pyModule;
+	entry.name = PyUnicode_InternFromString(functionName);
+	return &entry;
+}
+
+void GUIScript::ClearFunctionCache()
+{
+	for (auto& entry : functionCache) {
+		Py_XDECREF(entry.second.name);
+		Py_DECREF(entry.second.module);
+	}
+	functionCache.clear();
+	functionCacheGeneration++;
+}
+
+PyObject* GUIScript::RunPyFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+{
+	if (!Py_IsInitialized()) {
+		return NULL;
+	}
+
+	CachedFunction* cached = ResolveFunction(moduleName, functionName);
+	if (!cached) {
 		return NULL;
 	}
-	PyObject* dict = PyModule_GetDict(pyModule);
 
-	PyObject* pFunc = PyDict_GetItemString(dict, functionName);
+	// the module stays cached, but the function is looked up again through the interned
+	// name (one hashed probe), so rebinding or reloading it in python is still picked up
+	PyObject* dict = PyModule_GetDict(cached->module);
+	PyObject* pFunc = cached->name ? PyDict_GetItem(dict, cached->name) : nullptr;
 
 	/* pFunc: Borrowed reference */
-	if (!PyCallable_Check(pFunc)) {
+	if (!pFunc || !PyCallable_Check(pFunc)) {
 		if (report_error) {
 			Log(ERROR, "GUIScript", "Missing function: {} from {}", functionName, moduleName);
 		}
-		Py_DECREF(pyModule);
 		return NULL;
 	}
 
+	using namespace std::chrono;
+	unsigned int generation = functionCacheGeneration;
+	auto start = steady_clock::now();
 	PyObject* pValue = CallObjectWrapper(pFunc, pArgs);
+	// nested calls only add entries, which keeps ours in place, but a LoadScript clears them
+	if (generation == functionCacheGeneration) {
+		cached->stats.calls++;
+		cached->stats.time += duration_cast<microseconds>(steady_clock::now() - start);
+	}
+
 	if (!pValue) {
 		if (PyErr_Occurred()) {
 			PyErr_Print();
 		}
 	}
-	Py_DECREF(pyModule);
 	return pValue;
 }
 
+std::vector<std::pair<std::string, GUIScript::FunctionStats>> GUIScript::GetFunctionStats() const
+{
+	std::vector<std::pair<std::string, FunctionStats>> stats;
+	stats.reserve(functionCache.size());
+	for (const auto& entry : functionCache) {
+		if (entry.second.stats.calls) {
+			stats.emplace_back(entry.first, entry.second.stats);
+		}
+	}
+	std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+		return a.second.time > b.second.time;
+	});
+	return stats;
+}
+
 bool GUIScript::ExecFile(const char* file)
 {
 	FileStream fs;
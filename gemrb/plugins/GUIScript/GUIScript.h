@@ -26,6 +26,12 @@
 
 #include <Python.h>
 
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace GemRB {
 
 class View;
@@ -40,11 +46,30 @@ enum {
 };
 
 class GUIScript : public ScriptEngine {
+public:
+	struct FunctionStats {
+		unsigned long calls = 0;
+		std::chrono::microseconds time { 0 }; // inclusive of any nested script calls
+	};
+
 private:
+	struct CachedFunction {
+		PyObject* module = nullptr; // should decref it
+		PyObject* name = nullptr; // interned, should decref it
+		FunctionStats stats;
+	};
+
 	PyObject* pModule = nullptr; // should decref it
 	PyObject* pDict = nullptr; // borrowed, but used outside a function
 	PyObject* pMainDic = nullptr; // borrowed, but used outside a function
 	PyObject* pGUIClasses = nullptr;
+	// RunPyFunction lookups keyed by "module.function", dropped when the main script is reloaded
+	std::unordered_map<std::string, CachedFunction> functionCache;
+	std::string functionKey; // reused to build the lookup keys without allocating
+	unsigned int functionCacheGeneration = 0;
+
+	CachedFunction* ResolveFunction(const char* moduleName, const char* functionName);
+	void ClearFunctionCache();
 
 public:
 	GUIScript(void);
@@ -62,6 +87,8 @@ public:
 
 	PyObject* RunPyFunction(const char* moduleName, const char* fname, const FunctionParameters& params, bool report_error = true);
 	PyObject* RunPyFunction(const char* moduleName, const char* fname, PyObject* pArgs, bool report_error = true);
+	/** Call counts and cumulative time of every function run through RunPyFunction, slowest first */
+	std::vector<std::pair<std::string, FunctionStats>> GetFunctionStats() const;
 	/** Exec a single File */
 	bool ExecFile(const char* file);
 	/** Exec a single String */
@@ -89,6 +89,11 @@ static void FindBIF(BIFEntry* entry)
 	Log(ERROR, "KEYImporter", "Cannot find {}...", entry->name);
 }
 
+KEYImporter::KEYImporter()
+	: openArchives(std::max(core->config.MaxOpenArchives, 1))
+{
+}
+
 bool KEYImporter::Open(const path_t& resfile, std::string desc)
 {
 	description = std::move(desc);
@@ -182,7 +187,8 @@ bool KEYImporter::Open(const path_t& resfile, std::string desc)
 
 bool KEYImporter::HasResource(StringView resname, SClass_ID type)
 {
-	return resources.find({ ResRef(resname), type }) != resources.cend();
+	// same synonym masking as in GetResource, so both agree
+	return resources.find({ ResRef(resname), type & 0xFFFF }) != resources.cend();
 }
 
 bool KEYImporter::HasResource(StringView resname, const ResourceDesc& type)
@@ -213,9 +219,10 @@ DataStream* KEYImporter::GetStream(const ResRef& resname, ieWord type)
 		return NULL;
 	}
 
-	PluginHolder<IndexedArchive> ai = MakePluginHolder<IndexedArchive>(IE_BIF_CLASS_ID);
-	if (ai->OpenArchive(biffiles[bifnum].path) == GEM_ERROR) {
-		Log(ERROR, "KEYImporter", "Cannot open archive {}", biffiles[bifnum].path);
+	// the archive stream is shared, so keep other threads out until the slice is made
+	std::lock_guard<std::mutex> lock(archiveLock);
+	PluginHolder<IndexedArchive> ai = GetArchive(biffiles[bifnum]);
+	if (!ai) {
 		return NULL;
 	}
 
@@ -229,6 +236,24 @@ DataStream* KEYImporter::GetStream(const ResRef& resname, ieWord type)
 	return NULL;
 }
 
+PluginHolder<IndexedArchive> KEYImporter::GetArchive(const BIFEntry& bif)
+{
+	const ArchiveCacheEntry* cached = openArchives.Lookup(bif.path);
+	if (cached) {
+		openArchives.Touch(bif.path);
+		return cached->archive;
+	}
+
+	PluginHolder<IndexedArchive> ai = MakePluginHolder<IndexedArchive>(IE_BIF_CLASS_ID);
+	if (ai->OpenArchive(bif.path) == GEM_ERROR) {
+		Log(ERROR, "KEYImporter", "Cannot open archive {}", bif.path);
+		return nullptr;
+	}
+
+	openArchives.SetAt(bif.path, ai);
+	return ai;
+}
+
 DataStream* KEYImporter::GetResource(StringView resname, SClass_ID type)
 {
 	//the word masking is a hack for synonyms, currently used for bcs==bs
@@ -21,12 +21,14 @@
 #ifndef KEYIMP_H
 #define KEYIMP_H
 
+#include "LRUCache.h"
 #include "PluginMgr.h"
 #include "ResourceSource.h"
 
 #include "Plugins/IndexedArchive.h"
 #include "System/VFS.h"
 
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -72,22 +74,38 @@ struct MapKeyHash {
 	}
 };
 
-struct KEYCache {
-	KEYCache() { bifnum = 0xffffffff; }
+struct ArchiveCacheEntry {
+	PluginHolder<IndexedArchive> archive;
 
-	unsigned int bifnum;
-	PluginHolder<IndexedArchive> plugin;
+	explicit ArchiveCacheEntry(PluginHolder<IndexedArchive> archive)
+		: archive(std::move(archive)) {}
+
+	void evictionNotice() const { /* closed with the last holder */ }
+};
+
+struct ArchiveEvictable {
+	// slices clone the archive stream, so nothing handed out depends on it
+	bool operator()(const ArchiveCacheEntry&) const { return true; }
 };
 
+using ArchiveCache = LRUCache<ArchiveCacheEntry, ArchiveEvictable>;
+
 class KEYImporter : public ResourceSource {
 private:
 	std::vector<BIFEntry> biffiles;
 	std::unordered_map<MapKey, ieDword, MapKeyHash> resources;
+	// opened (and parsed) BIFs, bounded by the MaxOpenArchives setting
+	ArchiveCache openArchives;
+	std::mutex archiveLock;
 
 	/** Gets the stream associated to a RESKey */
 	DataStream* GetStream(const ResRef&, ieWord type);
+	/** Returns an opened archive from the pool, opening it if needed; call with archiveLock held */
+	PluginHolder<IndexedArchive> GetArchive(const BIFEntry& bif);
 
 public:
+	KEYImporter();
+
 	bool Open(const path_t& file, std::string desc) override;
 	/* predicts the availability of a resource */
 	bool HasResource(StringView resname, SClass_ID type) override;
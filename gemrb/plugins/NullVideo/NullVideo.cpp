@@ -0,0 +1,80 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "NullVideo.h"
+
+#include "Video/RLE.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+namespace GemRB {
+
+bool NullVideo::SetFullscreenMode(bool set)
+{
+	fullscreen = set;
+	return true;
+}
+
+Holder<Sprite2D> NullVideo::CreateSprite(const Region& rgn, void* pixels, const PixelFormat& fmt)
+{
+	// nothing knows how to iterate RLE sprites outside a real driver
+	if (fmt.RLE) {
+		void* newpixels = DecodeRLEData(static_cast<uint8_t*>(pixels), rgn.size, fmt.ColorKey);
+		free(pixels);
+		PixelFormat newfmt = fmt;
+		newfmt.RLE = false;
+		return MakeHolder<Sprite2D>(rgn, newpixels, newfmt, rgn.w * newfmt.Bpp);
+	}
+	// callers without pixels expect a blank buffer to fill in, like the SDL surfaces
+	if (!pixels) {
+		pixels = calloc(rgn.h * rgn.w, fmt.Bpp);
+	}
+	return MakeHolder<Sprite2D>(rgn, pixels, fmt, rgn.w * fmt.Bpp);
+}
+
+// a black one, saved games still want a preview
+Holder<Sprite2D> NullVideo::GetScreenshot(Region r, const VideoBufferPtr&)
+{
+	int width = r.w ? r.w : screenSize.w;
+	int height = r.h ? r.h : screenSize.h;
+
+	static const PixelFormat fmt(3, 0x00ff0000, 0x0000ff00, 0x000000ff, 0);
+	void* pixels = calloc(width * height, fmt.Bpp);
+	return MakeHolder<Sprite2D>(Region(0, 0, width, height), pixels, fmt, width * fmt.Bpp);
+}
+
+void NullVideo::Wait(uint32_t ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+VideoBuffer* NullVideo::NewVideoBuffer(const Region& r, BufferFormat)
+{
+	return new NullVideoBuffer(r);
+}
+
+}
+
+#include "plugindef.h"
+
+GEMRB_PLUGIN(0x2A91D6E3, "Null Video Driver")
+PLUGIN_DRIVER(NullVideo, "none")
+END_PLUGIN()
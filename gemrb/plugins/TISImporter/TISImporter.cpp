@@ -70,28 +70,20 @@ bool TISImporter::Open(DataStream* stream)
 Tile* TISImporter::GetTile(const std::vector<ieWord>& indexes,
 			   unsigned short* secondary)
 {
+	// nothing is decoded here, the overlay does it once the frames are drawn
 	size_t count = indexes.size();
-	std::vector<Animation::frame_t> frames;
-	frames.reserve(count);
-	for (size_t i = 0; i < count; i++) {
-		frames.push_back(GetTile(indexes[i]));
-	}
-
-	Animation ani = Animation(std::move(frames), ANI_DEFAULT_FRAMERATE);
+	Animation ani = Animation(std::vector<Animation::frame_t>(count), ANI_DEFAULT_FRAMERATE);
 	//pause key stops animation
 	ani.gameAnimation = true;
 	//the turning crystal in ar3202 (bg1) requires animations to be synced
 	ani.frameIdx = 0;
 
 	if (secondary) {
-		frames.clear();
-		for (size_t i = 0; i < count; i++) {
-			frames.push_back(GetTile(secondary[i]));
-		}
-		Animation sec = Animation(std::move(frames), ANI_DEFAULT_FRAMERATE);
-		return new Tile(std::move(ani), std::move(sec));
+		std::vector<ieWord> secondaryIndexes(secondary, secondary + count);
+		Animation sec = Animation(std::vector<Animation::frame_t>(count), ANI_DEFAULT_FRAMERATE);
+		return new Tile(std::move(ani), indexes, std::move(sec), std::move(secondaryIndexes));
 	}
-	return new Tile(std::move(ani));
+	return new Tile(std::move(ani), indexes);
 }
 
 Holder<Sprite2D> TISImporter::GetTile(int index)
@@ -57,7 +57,7 @@ public:
 	bool Open(DataStream* stream) override;
 	Tile* GetTile(const std::vector<ieWord>& indexes,
 		      unsigned short* secondary = NULL) override;
-	Holder<Sprite2D> GetTile(int index);
+	Holder<Sprite2D> GetTile(int index) override;
 };
 
 }
@@ -117,7 +117,7 @@ int WEDImporter::AddOverlay(TileMap* tm, const Overlay* newOverlays, bool rain)
 	}
 	PluginHolder<TileSetMgr> tis = MakePluginHolder<TileSetMgr>(IE_TIS_CLASS_ID);
 	tis->Open(tisfile);
-	auto over = MakeHolder<TileOverlay>(newOverlays->size);
+	auto over = MakeHolder<TileOverlay>(newOverlays->size, tis);
 	for (int y = 0; y < newOverlays->size.h; y++) {
 		for (int x = 0; x < newOverlays->size.w; x++) {
 			str->Seek(newOverlays->TilemapOffset + (y * newOverlays->size.w + x) * 10, GEM_STREAM_START);
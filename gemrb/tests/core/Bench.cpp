@@ -0,0 +1,200 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "Bench.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+
+// count every allocation in the test binary, core and plugins included
+static std::atomic<size_t> allocations { 0 };
+
+static void* CountedAlloc(size_t size)
+{
+	++allocations;
+	void* ptr = malloc(size ? size : 1);
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new(size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	++allocations;
+	return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	++allocations;
+	return malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	free(ptr);
+}
+
+// over-aligned types, when the compiler is in C++17 mode or enables aligned new anyway
+#ifdef __cpp_aligned_new
+static void* CountedAlignedAlloc(size_t size, std::align_val_t align) noexcept
+{
+	++allocations;
+	size_t alignment = std::max(size_t(align), sizeof(void*));
+	#ifdef WIN32
+	return _aligned_malloc(size ? size : 1, alignment);
+	#else
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, alignment, size ? size : 1)) {
+		return nullptr;
+	}
+	return ptr;
+	#endif
+}
+
+static void AlignedFree(void* ptr) noexcept
+{
+	#ifdef WIN32
+	_aligned_free(ptr);
+	#else
+	free(ptr);
+	#endif
+}
+
+void* operator new(size_t size, std::align_val_t align)
+{
+	void* ptr = CountedAlignedAlloc(size, align);
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t align)
+{
+	return operator new(size, align);
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	return CountedAlignedAlloc(size, align);
+}
+
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	return CountedAlignedAlloc(size, align);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	AlignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+	AlignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	AlignedFree(ptr);
+}
+#endif
+
+namespace GemRB {
+
+size_t AllocationCount()
+{
+	return allocations;
+}
+
+void LogBenchmark(const char* name, std::vector<uint64_t> samples, size_t allocs, size_t items)
+{
+	if (samples.empty()) return;
+
+	std::sort(samples.begin(), samples.end());
+	uint64_t total = std::accumulate(samples.begin(), samples.end(), uint64_t(0));
+	auto us = [](uint64_t ns) { return ns / 1000.0; };
+	auto percentile = [&samples](size_t p) { return samples[std::min(samples.size() - 1, samples.size() * p / 100)]; };
+	// printed directly, the core log is only set up by some of the fixtures
+	fmt::print("[Bench]: {}: {} runs, mean {:.1f} us, median {:.1f} us, 95% {:.1f} us, 99% {:.1f} us, max {:.1f} us, {:.1f} allocations per run\n",
+	    name, samples.size(), us(total) / samples.size(), us(percentile(50)), us(percentile(95)), us(percentile(99)), us(samples.back()),
+	    double(allocs) / samples.size());
+	if (items > 1) {
+		fmt::print("[Bench]: {}: {:.1f} ns per item\n", name, double(total) / samples.size() / items);
+	}
+}
+
+}
@@ -0,0 +1,49 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TESTS_BENCH_H
+#define TESTS_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace GemRB {
+
+// timing helpers for the benchmarks that run as part of the core tests
+// they only report, so a slow build bot doesn't fail them
+
+using BenchClock = std::chrono::steady_clock;
+
+inline uint64_t ElapsedNs(BenchClock::time_point since)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - since).count());
+}
+
+// number of global operator new and new[] calls, aligned and nothrow ones included,
+// since the program started
+size_t AllocationCount();
+
+// logs the mean, median, 95th and 99th percentile and max of the samples,
+// plus the allocations per sample; with items > 1 also the ns per item
+void LogBenchmark(const char* name, std::vector<uint64_t> samples, size_t allocations, size_t items = 1);
+
+}
+
+#endif
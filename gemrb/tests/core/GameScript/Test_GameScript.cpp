@@ -0,0 +1,79 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../Bench.h"
+#include "../MapTest.h"
+
+#include "../../../core/GameScript/GameScript.h"
+#include "../../../core/Scriptable/Actor.h"
+
+#include <memory>
+
+namespace GemRB {
+
+// every compiled script the demo ships
+static const ResRef corpus[] = { "ar0100", "cav0end", "dplayer3", "randwalk", "randwlkc", "scene01" };
+
+// runs the demo scripts for a crowd of actors, the way the area does every script round;
+// the actors are kept busy and uninterruptible, so the first matching block is found
+// but not run and every round evaluates the same conditions again
+TEST_F(MapTest, ScriptCorpusBenchmark)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(100, 100), 100, 0));
+	std::mt19937 rng(3);
+
+	std::vector<std::unique_ptr<GameScript>> scripts;
+	for (int i = 0; i < 40; ++i) {
+		Actor* actor = gamedata->GetCreature("rabbit");
+		ASSERT_NE(actor, nullptr);
+		// queued before joining the area, so it isn't run right away
+		actor->AddAction("Wait(1000)");
+		actor->SetInternalFlag(IF_NOINT, BitOp::OR);
+		actor->SetPos(Point(rng() % 1600, rng() % 1200));
+		area->AddActor(actor, false);
+		actor->Scriptable::SetMap(area.get());
+		for (const ResRef& resRef : corpus) {
+			scripts.emplace_back(new GameScript(resRef, actor));
+		}
+	}
+
+	// a first round warms up the caches
+	for (const auto& script : scripts) {
+		script->Update();
+	}
+
+	std::vector<uint64_t> times;
+	size_t allocations = AllocationCount();
+	for (int round = 0; round < 100; ++round) {
+		auto start = BenchClock::now();
+		for (const auto& script : scripts) {
+			script->Update();
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	allocations = AllocationCount() - allocations;
+
+	LogBenchmark("BCS corpus script round", std::move(times), allocations, scripts.size());
+}
+
+}
+#endif
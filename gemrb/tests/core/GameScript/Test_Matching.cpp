@@ -0,0 +1,149 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "../MapTest.h"
+
+#include "../../../includes/ie_stats.h"
+
+#include "../../../core/GameScript/GameScript.h"
+#include "../../../core/GameScript/Matching.h"
+#include "../../../core/GameScript/Targets.h"
+#include "../../../core/Scriptable/Actor.h"
+
+namespace GemRB {
+
+static const int eaValues[] = { EA_PC, EA_ALLY, EA_GOODBUTRED, EA_NEUTRAL, EA_EVILCUTOFF, EA_ENEMY };
+static const int generalValues[] = { GEN_HUMANOID, GEN_ANIMAL, GEN_UNDEAD };
+static const int raceValues[] = { 1, 2, 3, 4 };
+static const int specificValues[] = { 0, 1, 2 };
+static const int genderValues[] = { SEX_MALE, SEX_FEMALE, SEX_NEITHER };
+static const int alignmentValues[] = { 0x11, 0x12, 0x22, 0x23, 0x33 };
+
+template<typename T, size_t N>
+static int Pick(std::mt19937& rng, const T (&values)[N])
+{
+	return values[rng() % N];
+}
+
+static void RandomizeStats(Actor* actor, std::mt19937& rng)
+{
+	actor->SetStat(IE_EA, Pick(rng, eaValues), 0);
+	actor->SetStat(IE_GENERAL, Pick(rng, generalValues), 0);
+	actor->SetStat(IE_RACE, Pick(rng, raceValues), 0);
+	actor->SetStat(IE_SPECIFIC, Pick(rng, specificValues), 0);
+	actor->SetStat(IE_SEX, Pick(rng, genderValues), 0);
+	actor->SetStat(IE_ALIGNMENT, Pick(rng, alignmentValues), 0);
+}
+
+// the demo uses the usual [ea.general.race.class.specific.gender.alignment] fields
+static bool ScanMatches(const Actor* actor, const Object& object)
+{
+	using IDSCheck = int (*)(const Actor*, int);
+	static const IDSCheck checks[] = {
+		GameScript::ID_Allegiance, GameScript::ID_General, GameScript::ID_Race, GameScript::ID_Class,
+		GameScript::ID_Specific, GameScript::ID_Gender, GameScript::ID_Alignment
+	};
+	for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); ++i) {
+		if (object.objectFields[i] && !checks[i](actor, object.objectFields[i])) return false;
+	}
+	return actor->ValidTarget(GA_NO_DEAD);
+}
+
+static std::vector<const Actor*> Collect(Targets* targets)
+{
+	std::vector<const Actor*> found;
+	if (!targets) return found;
+
+	targetlist::iterator it;
+	for (const targettype* target = targets->GetFirstTarget(it, ST_ACTOR); target; target = targets->GetNextTarget(it, ST_ACTOR)) {
+		found.push_back(static_cast<const Actor*>(target->actor));
+	}
+	delete targets;
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+// IDS targeting starts from the candidates of the map's stat index, which has
+// to come up with the same actors as checking every single one of them
+TEST_F(MapTest, IDSTargetingMatchesScan)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(100, 100), 100, 0));
+	std::mt19937 rng(11);
+
+	for (int i = 0; i < 80; ++i) {
+		Actor* actor = gamedata->GetCreature("rabbit");
+		ASSERT_NE(actor, nullptr);
+		actor->SetPos(Point(rng() % 1600, rng() % 1200));
+		// half get their stats before joining, the rest after
+		if (i % 2) RandomizeStats(actor, rng);
+		area->AddActor(actor, false);
+		actor->Scriptable::SetMap(area.get());
+		if (i % 2 == 0) RandomizeStats(actor, rng);
+	}
+
+	static const int eaParameters[] = { EA_PC, EA_ENEMY, EA_GOODCUTOFF, EA_NOTGOOD, EA_NOTNEUTRAL, EA_NOTEVIL, EA_EVILCUTOFF, EA_ANYTHING };
+	static const int alignmentParameters[] = { 0x01, 0x10, 0x22, 0x03, 0x30 };
+	size_t matches = 0;
+	for (int round = 0; round < 5; ++round) {
+		// change some of the stats the index keeps
+		for (int i = 0; i < 20; ++i) {
+			RandomizeStats(area->GetAllActors()[rng() % area->GetAllActors().size()], rng);
+		}
+
+		for (int query = 0; query < 40; ++query) {
+			Object object;
+			switch (query % 4) {
+				case 0:
+					object.objectFields[0] = Pick(rng, eaParameters);
+					break;
+				case 1:
+					object.objectFields[1] = Pick(rng, generalValues);
+					object.objectFields[2] = Pick(rng, raceValues);
+					break;
+				case 2:
+					object.objectFields[5] = Pick(rng, genderValues);
+					object.objectFields[6] = Pick(rng, alignmentParameters);
+					break;
+				default:
+					object.objectFields[0] = Pick(rng, eaParameters);
+					object.objectFields[4] = Pick(rng, specificValues);
+					object.objectFields[6] = Pick(rng, alignmentParameters);
+					break;
+			}
+
+			std::vector<const Actor*> expected;
+			for (const Actor* actor : area->GetAllActors()) {
+				if (ScanMatches(actor, object)) expected.push_back(actor);
+			}
+			std::sort(expected.begin(), expected.end());
+
+			std::vector<const Actor*> found = Collect(GetAllObjects(area.get(), area.get(), &object, 0));
+			EXPECT_EQ(found, expected) << object.dump(false);
+			matches += found.size();
+		}
+	}
+	// the queries need to have found something to compare
+	EXPECT_GT(matches, 0u);
+}
+
+}
+#endif
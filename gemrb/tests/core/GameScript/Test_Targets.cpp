@@ -0,0 +1,209 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "../../../core/GameScript/Targets.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+static bool IsAligned(const void* ptr)
+{
+	return reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+TEST(TargetArenaTest, AllocatesAlignedAndDistinct)
+{
+	TargetArena::Scope scope;
+
+	char* a = static_cast<char*>(TargetArena::Allocate(1));
+	char* b = static_cast<char*>(TargetArena::Allocate(17));
+	char* c = static_cast<char*>(TargetArena::Allocate(100));
+	EXPECT_TRUE(IsAligned(a));
+	EXPECT_TRUE(IsAligned(b));
+	EXPECT_TRUE(IsAligned(c));
+	EXPECT_GE(b, a + 1);
+	EXPECT_GE(c, b + 17);
+
+	// larger than a chunk and enough to fill several
+	void* big = TargetArena::Allocate(100 * 1024);
+	EXPECT_NE(big, nullptr);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_TRUE(IsAligned(TargetArena::Allocate(4000)));
+	}
+}
+
+TEST(TargetArenaTest, ReusesMemoryAfterScope)
+{
+	void* first;
+	{
+		TargetArena::Scope scope;
+		first = TargetArena::Allocate(64);
+		TargetArena::Allocate(64);
+	}
+	TargetArena::Scope scope;
+	EXPECT_EQ(TargetArena::Allocate(64), first);
+}
+
+TEST(TargetArenaTest, NestedScopesRewindToTheirMark)
+{
+	TargetArena::Scope outer;
+	void* kept = TargetArena::Allocate(64);
+	void* inner;
+	{
+		TargetArena::Scope scope;
+		inner = TargetArena::Allocate(64);
+		// spill into further chunks, the rewind has to come back across them
+		for (int i = 0; i < 50; ++i) {
+			TargetArena::Allocate(4000);
+		}
+	}
+	void* again = TargetArena::Allocate(64);
+	EXPECT_EQ(again, inner);
+	EXPECT_NE(again, kept);
+}
+
+TEST(TargetArenaTest, DeallocateOnlyRewindsTheLastAllocation)
+{
+	TargetArena::Scope scope;
+	void* a = TargetArena::Allocate(32);
+	void* b = TargetArena::Allocate(32);
+
+	// not the top, stays taken until the scope ends
+	TargetArena::Deallocate(a, 32);
+	void* c = TargetArena::Allocate(32);
+	EXPECT_NE(c, a);
+	EXPECT_NE(c, b);
+
+	TargetArena::Deallocate(c, 32);
+	EXPECT_EQ(TargetArena::Allocate(32), c);
+}
+
+TEST(TargetArenaTest, LeakOnlyPinsItsOwnScope)
+{
+	size_t live = TargetArena::LiveTargets();
+	Targets* leaked;
+	void* used;
+	{
+		TargetArena::Scope scope;
+		leaked = new Targets();
+		used = TargetArena::Allocate(64);
+
+		// the rewind is skipped, so new allocations can't hand out memory still in use
+		EXPECT_FALSE(scope.Rewind());
+		EXPECT_EQ(TargetArena::LiveTargets(), live + 1);
+		EXPECT_NE(TargetArena::Allocate(64), used);
+		EXPECT_NE(TargetArena::Allocate(sizeof(Targets)), leaked);
+	}
+
+	// later scopes start above the leak and rewind as usual
+	void* first;
+	{
+		TargetArena::Scope scope;
+		first = TargetArena::Allocate(64);
+		EXPECT_NE(first, used);
+		Targets copy(*leaked);
+		EXPECT_FALSE(scope.Rewind());
+	}
+	{
+		TargetArena::Scope scope;
+		EXPECT_EQ(TargetArena::Allocate(64), first);
+		EXPECT_TRUE(scope.Rewind());
+	}
+
+	delete leaked;
+	EXPECT_EQ(TargetArena::LiveTargets(), live);
+}
+
+TEST(TargetArenaTest, GrowingListsKeepTheirContents)
+{
+	TargetArena::Scope scope;
+
+	targetlist list;
+	for (unsigned int i = 0; i < 5000; ++i) {
+		list.push_back({ nullptr, i });
+	}
+	for (unsigned int i = 0; i < 5000; ++i) {
+		ASSERT_EQ(list[i].distance, i);
+	}
+}
+
+struct TestDoor : Scriptable {
+	TestDoor()
+		: Scriptable(ST_DOOR) {}
+	std::string dump() const override { return {}; }
+};
+
+TEST(TargetsTest, RemovedEntriesAreSkipped)
+{
+	TargetArena::Scope scope;
+	std::vector<std::unique_ptr<TestDoor>> scriptables;
+	Scriptable* doors[5];
+	Targets tgts;
+	for (unsigned int i = 0; i < 5; ++i) {
+		scriptables.emplace_back(new TestDoor());
+		doors[i] = scriptables.back().get();
+		tgts.AddTarget(doors[i], i, 0);
+	}
+
+	// drop the nearest, then every other one while walking the list
+	tgts.Pop();
+	targetlist::iterator m;
+	const targettype* tt = tgts.GetFirstTarget(m, ST_ANY);
+	ASSERT_NE(tt, nullptr);
+	EXPECT_EQ(tt->actor, doors[1]);
+	tt = tgts.RemoveTargetAt(m);
+	ASSERT_NE(tt, nullptr);
+	EXPECT_EQ(tt->actor, doors[2]);
+	tt = tgts.GetNextTarget(m, ST_ANY);
+	ASSERT_NE(tt, nullptr);
+	EXPECT_EQ(tt->actor, doors[3]);
+	tt = tgts.RemoveTargetAt(m);
+	ASSERT_NE(tt, nullptr);
+	EXPECT_EQ(tt->actor, doors[4]);
+	EXPECT_EQ(tgts.GetNextTarget(m, ST_ANY), nullptr);
+
+	EXPECT_EQ(tgts.Count(), 2U);
+	EXPECT_EQ(tgts.GetTarget(0, ST_ANY), doors[2]);
+	EXPECT_EQ(tgts.GetTarget(1, ST_ANY), doors[4]);
+	EXPECT_EQ(tgts.GetTarget(2, ST_ANY), nullptr);
+	EXPECT_EQ(tgts.GetLastTarget(ST_ANY)->actor, doors[4]);
+
+	// new entries still land in distance order among the removed ones
+	tgts.AddTarget(doors[0], 1, 0);
+	EXPECT_EQ(tgts.Count(), 3U);
+	EXPECT_EQ(tgts.GetTarget(0, ST_ANY), doors[0]);
+	EXPECT_EQ(tgts.GetTarget(1, ST_ANY), doors[2]);
+
+	Targets copy(tgts);
+	EXPECT_EQ(copy.Count(), 3U);
+	copy.Pop();
+	copy.Pop();
+	copy.Pop();
+	EXPECT_EQ(copy.Count(), 0U);
+	EXPECT_EQ(copy.GetFirstTarget(m, ST_ANY), nullptr);
+}
+
+}
@@ -0,0 +1,110 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TESTS_MAPTEST_H
+#define TESTS_MAPTEST_H
+
+#include "../../core/GameData.h"
+#include "../../core/Interface.h"
+#include "../../core/InterfaceConfig.h"
+#include "../../core/Logging/Loggers/Stdio.h"
+#include "../../core/Logging/Logging.h"
+#include "../../core/Map.h"
+#include "../../core/PluginMgr.h"
+#include "../../core/SaveGameMgr.h"
+#include "../../core/Sprite2D.h"
+#include "../../core/TileMap.h"
+#include "../../core/Video/Video.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace GemRB {
+
+class MapTest : public testing::Test {
+public:
+	static const Interface* gemrb;
+	static const Map* map;
+
+	// set up core and the first map from the demo
+	static void SetUpTestSuite()
+	{
+		setlocale(LC_ALL, "");
+		const char* argv[] = { "tester", "-c", "../../tester.cfg" };
+		auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
+		// test data on top of the demo, like the opcodes of the effects the demo doesn't use
+		cfg.ModPath.push_back(PathJoin("tests", "resources", "MapTest"));
+		ToggleLogging(true);
+		AddLogWriter(createStdioLogWriter());
+		gemrb = new Interface(std::move(cfg));
+
+		auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
+		auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
+		Game* game = gamMgr->LoadGame(new Game(), 0);
+		core->SetGame(game);
+
+		ResRef mapRef { "ar0100" };
+		map = game->GetMap(mapRef, false);
+	}
+
+	// an area of the given searchmap size, passable but for a reproducible scatter of
+	// impassable blocks covering about obstaclePercent of it
+	static Map* MakeSyntheticMap(const Size& size, unsigned int seed, int obstaclePercent)
+	{
+		Holder<Sprite2D> props = VideoDriver->CreateSprite(Region(Point(), size), nullptr, TileProps::pixelFormat);
+		uint32_t* pixels = static_cast<uint32_t*>(props->LockSprite());
+		const uint32_t open = uint32_t(PathMapFlags::PASSABLE) << 24 | uint32_t(TileProps::defaultElevation) << 8;
+		std::fill(pixels, pixels + size.Area(), open);
+
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> side(2, 12);
+		std::uniform_int_distribution<int> xs(0, size.w - 1);
+		std::uniform_int_distribution<int> ys(0, size.h - 1);
+		int blocked = 0;
+		while (blocked * 100 < size.Area() * obstaclePercent) {
+			int x0 = xs(rng);
+			int y0 = ys(rng);
+			int w = std::min(side(rng), size.w - x0);
+			int h = std::min(side(rng), size.h - y0);
+			for (int y = y0; y < y0 + h; ++y) {
+				std::fill(pixels + y * size.w + x0, pixels + y * size.w + x0 + w, uint32_t(0));
+			}
+			blocked += w * h;
+		}
+
+		TileMap* tmap = new TileMap();
+		tmap->XCellCount = CeilDiv<int>(size.w * 16, 64);
+		tmap->YCellCount = CeilDiv<int>(size.h * 12, 64);
+		return new Map(tmap, TileProps(std::move(props)), nullptr);
+	}
+
+	static void TearDownTestSuite()
+	{
+		// cleanup to prevent a delay and crash on exit
+		delete core->GetGame();
+		core->SetGame(nullptr);
+		VideoDriver.reset();
+		delete gemrb;
+	}
+};
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "Streams/FileStream.h"
 #include "Streams/MappedFileMemoryStream.h"
 #include "Streams/MemoryStream.h"
+#include "Streams/SlicedStream.h"
 #include "System/VFS.h"
 
 #include <gtest/gtest.h>
@@ -171,6 +172,49 @@ TEST_P(DataStreamReadingTest, ReadLine)
 	EXPECT_EQ(buffer, "Line4");
 }
 
+TEST_P(DataStreamReadingTest, ClonesReadIndependently)
+{
+	stream->Seek(2, GEM_STREAM_START);
+	DataStream* clone = stream->Clone();
+	ASSERT_NE(clone, nullptr);
+	EXPECT_EQ(clone->GetPos(), 0);
+	EXPECT_EQ(clone->Size(), stream->Size());
+
+	uint8_t byte;
+	clone->ReadScalar(byte);
+	EXPECT_EQ(byte, 0x01);
+	stream->ReadScalar(byte);
+	EXPECT_EQ(byte, 0x02);
+
+	// the clone has to outlive its origin
+	delete stream;
+	this->stream = nullptr;
+	clone->ReadScalar(byte);
+	EXPECT_EQ(byte, 0x01);
+	clone->ReadScalar(byte);
+	EXPECT_EQ(byte, 0x02);
+	delete clone;
+}
+
+TEST_P(DataStreamReadingTest, Slices)
+{
+	SlicedStream slice(stream, 2, 4);
+	EXPECT_EQ(slice.Size(), 4);
+
+	uint16_t two;
+	slice.ReadScalar(two);
+	EXPECT_EQ(two, 0x0102);
+
+	const uint8_t* view = slice.GetView();
+	if (stream->GetView()) {
+		ASSERT_NE(view, nullptr);
+		EXPECT_EQ(view[0], 0x02);
+		EXPECT_EQ(view[3], 0x0b);
+	} else {
+		EXPECT_EQ(view, nullptr);
+	}
+}
+
 TEST_P(DataStreamDecryptionTest, ReadEncryptedValues)
 {
 	EXPECT_TRUE(stream->CheckEncrypted());
@@ -183,6 +227,24 @@ TEST_P(DataStreamDecryptionTest, ReadEncryptedValues)
 	}
 }
 
+TEST_P(DataStreamDecryptionTest, ClonesStartOnTheRawData)
+{
+	strpos_t rawSize = stream->Size();
+	EXPECT_TRUE(stream->CheckEncrypted());
+	EXPECT_EQ(stream->Size(), rawSize - 2);
+
+	DataStream* clone = stream->Clone();
+	ASSERT_NE(clone, nullptr);
+	EXPECT_EQ(clone->Size(), rawSize);
+	EXPECT_TRUE(clone->CheckEncrypted());
+	for (uint8_t i = 0; i < 64; ++i) {
+		uint8_t v;
+		clone->ReadScalar(v);
+		EXPECT_EQ(v, i);
+	}
+	delete clone;
+}
+
 TEST(DataStreamWritingTest, Writes)
 {
 	void* buffer = malloc(35);
@@ -0,0 +1,123 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "MapTest.h"
+
+#include "../../core/Scriptable/Actor.h"
+
+namespace GemRB {
+
+// the same checks Map::GetActorsInRect, GetAllActorsInRadius and GetActor do, over the plain actor list
+static std::vector<Actor*> ScanRect(const Map& area, const Region& rgn)
+{
+	std::vector<Actor*> found;
+	for (Actor* actor : area.GetAllActors()) {
+		if (!actor->ValidTarget(0)) continue;
+		if (!rgn.PointInside(actor->Pos) && !actor->IsOver(rgn.origin)) continue;
+		found.push_back(actor);
+	}
+	return found;
+}
+
+static std::vector<Actor*> ScanRadius(const Map& area, const Point& p, unsigned int radius)
+{
+	std::vector<Actor*> found;
+	for (Actor* actor : area.GetAllActors()) {
+		if (!WithinRange(actor, p, radius)) continue;
+		if (!actor->ValidTarget(GA_NO_LOS)) continue;
+		found.push_back(actor);
+	}
+	return found;
+}
+
+static Actor* ScanPoint(const Map& area, const Point& p)
+{
+	for (Actor* actor : area.GetAllActors()) {
+		if (actor->IsOver(p) && actor->ValidTarget(0)) return actor;
+	}
+	return nullptr;
+}
+
+// actors placed the ways the importers do it, before and after joining the area,
+// then moved around with both MoveTo and SetPos
+TEST_F(MapTest, ActorGridMatchesLinearScan)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(200, 200), 200, 0));
+	std::mt19937 rng(9);
+	std::uniform_int_distribution<int> xs(0, 200 * 16 - 1);
+	std::uniform_int_distribution<int> ys(0, 200 * 12 - 1);
+
+	// the areas are set with the plain Scriptable::SetMap, since the actor
+	// one also equips items, which needs more data than the demo has
+	constexpr int actorCount = 60;
+	for (int i = 0; i < actorCount; ++i) {
+		Actor* actor = gamedata->GetCreature("rabbit");
+		ASSERT_NE(actor, nullptr);
+		if (i % 2) {
+			// like GAMImporter, before the actor joins
+			actor->SetPos(Point(xs(rng), ys(rng)));
+			area->AddActor(actor, false);
+			actor->Scriptable::SetMap(area.get());
+		} else {
+			// like AREImporter, in between being listed and InitActors setting the area
+			area->AddActor(actor, false);
+			actor->SetPos(Point(xs(rng), ys(rng)));
+			actor->Scriptable::SetMap(area.get());
+		}
+	}
+
+	size_t matches = 0;
+	for (int round = 0; round < 10; ++round) {
+		for (Actor* actor : area->GetAllActors()) {
+			// keep some still and move the rest close by or across the area
+			switch (rng() % 3) {
+				case 0:
+					break;
+				case 1:
+					actor->MoveTo(Point(xs(rng), ys(rng)));
+					break;
+				default:
+					actor->SetPos(Clamp(actor->Pos + Point(int(rng() % 200) - 100, int(rng() % 200) - 100), Point(), Point(200 * 16 - 1, 200 * 12 - 1)));
+					break;
+			}
+		}
+
+		for (int query = 0; query < 20; ++query) {
+			Point p(xs(rng), ys(rng));
+			Region rgn(p, Size(400, 300));
+			std::vector<Actor*> inRect = area->GetActorsInRect(rgn, 0);
+			EXPECT_EQ(inRect, ScanRect(*area, rgn));
+			std::vector<Actor*> inRadius = area->GetAllActorsInRadius(p, GA_NO_LOS, 30);
+			EXPECT_EQ(inRadius, ScanRadius(*area, p, 30));
+			matches += inRect.size() + inRadius.size();
+
+			// somewhere someone stands
+			const Actor* someone = area->GetAllActors()[rng() % actorCount];
+			EXPECT_EQ(area->GetActor(someone->Pos, 0), ScanPoint(*area, someone->Pos));
+		}
+	}
+	// the queries need to have found something to compare
+	EXPECT_GT(matches, 0u);
+}
+
+}
+#endif
@@ -0,0 +1,134 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "MapTest.h"
+
+#include "../../core/EffectQueue.h"
+
+#include <map>
+
+namespace GemRB {
+
+static const ieDword opcodes[] = { 12, 15, 44, 300 };
+
+// references with the opcode already set, so they don't depend on effects.ids
+static EffectRef OpcodeRef(ieDword opcode)
+{
+	return { "IndexTest", int(opcode) };
+}
+
+// the opcode lookups go through the index, so they have to agree with walking the queue:
+// the same number of effects per opcode and each effect at its queue position among them
+static void ExpectIndexMatchesQueue(const EffectQueue& queue)
+{
+	std::map<ieDword, ieDword> counts;
+	std::map<ieDword, ieDword> liveCounts; // the order only counts live effects
+	auto f = queue.GetFirstEffect();
+	for (const Effect* fx = queue.GetNextEffect(f); fx; fx = queue.GetNextEffect(f)) {
+		++counts[fx->Opcode];
+		if (fx->TimingMode == FX_DURATION_JUST_EXPIRED) continue;
+
+		EffectRef ref = OpcodeRef(fx->Opcode);
+		EXPECT_EQ(queue.GetEffectOrder(ref, fx), ++liveCounts[fx->Opcode]) << "opcode " << fx->Opcode;
+	}
+	for (ieDword opcode : opcodes) {
+		EffectRef ref = OpcodeRef(opcode);
+		EXPECT_EQ(queue.CountEffects(ref, 0xffffffff, 0xffffffff), counts[opcode]) << "opcode " << opcode;
+	}
+}
+
+static Effect* MakeEffect(std::mt19937& rng, ieDword id)
+{
+	Effect* fx = new Effect();
+	fx->Opcode = opcodes[rng() % (sizeof(opcodes) / sizeof(opcodes[0]))];
+	fx->Parameter1 = id;
+	fx->Parameter2 = rng() % 3;
+	fx->TimingMode = FX_DURATION_INSTANT_WHILE_EQUIPPED;
+	return fx;
+}
+
+TEST_F(MapTest, EffectIndexFollowsQueue)
+{
+	std::mt19937 rng(5);
+	EffectQueue queue;
+	ieDword id = 0;
+
+	for (int round = 0; round < 20; ++round) {
+		for (int i = 0; i < 30; ++i) {
+			queue.AddEffect(MakeEffect(rng, id++), rng() % 2);
+		}
+		ExpectIndexMatchesQueue(queue);
+
+		// remove a few by content
+		for (int i = 0; i < 5; ++i) {
+			auto f = queue.GetFirstEffect();
+			size_t skip = rng() % queue.GetEffectsCount();
+			const Effect* fx = queue.GetNextEffect(f);
+			while (skip--) {
+				fx = queue.GetNextEffect(f);
+			}
+			Effect copy = *fx;
+			EXPECT_TRUE(queue.RemoveEffect(&copy));
+		}
+		ExpectIndexMatchesQueue(queue);
+
+		// expire some, check them while marked and after the cleanup
+		auto f = queue.GetFirstEffect();
+		for (Effect* fx = queue.GetNextEffect(f); fx; fx = queue.GetNextEffect(f)) {
+			if (rng() % 4 == 0) fx->TimingMode = FX_DURATION_JUST_EXPIRED;
+		}
+		ExpectIndexMatchesQueue(queue);
+		queue.Cleanup();
+		ExpectIndexMatchesQueue(queue);
+
+		if (round % 5 == 4) {
+			queue.RemoveAllEffects(opcodes[rng() % (sizeof(opcodes) / sizeof(opcodes[0]))]);
+			ExpectIndexMatchesQueue(queue);
+		}
+	}
+	ASSERT_GT(queue.GetEffectsCount(), 0U);
+
+	// copies get their own index, moves take it along
+	EffectQueue copy(queue);
+	ExpectIndexMatchesQueue(copy);
+	queue.AddEffect(MakeEffect(rng, id++), true);
+	ExpectIndexMatchesQueue(queue);
+	ExpectIndexMatchesQueue(copy);
+
+	EffectQueue assigned;
+	assigned.AddEffect(MakeEffect(rng, id++));
+	assigned = copy;
+	ExpectIndexMatchesQueue(assigned);
+
+	EffectQueue moved(std::move(copy));
+	ExpectIndexMatchesQueue(moved);
+	ExpectIndexMatchesQueue(copy);
+	moved.AddEffect(MakeEffect(rng, id++), true);
+	ExpectIndexMatchesQueue(moved);
+
+	assigned = std::move(moved);
+	ExpectIndexMatchesQueue(assigned);
+	EXPECT_EQ(assigned.GetEffectsCount(), queue.GetEffectsCount());
+}
+
+}
+#endif
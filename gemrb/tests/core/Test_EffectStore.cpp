@@ -0,0 +1,163 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/EffectStore.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static Effect MakeEffect(ieDword opcode)
+{
+	Effect fx;
+	fx.Opcode = opcode;
+	return fx;
+}
+
+static std::vector<ieDword> Opcodes(const EffectStore& store)
+{
+	std::vector<ieDword> opcodes;
+	for (const Effect& fx : store) {
+		opcodes.push_back(fx.Opcode);
+	}
+	return opcodes;
+}
+
+TEST(EffectStoreTest, KeepsInsertionOrder)
+{
+	EffectStore store;
+	EXPECT_TRUE(store.empty());
+
+	store.push_back(MakeEffect(2));
+	store.push_back(MakeEffect(3));
+	store.push_front(MakeEffect(1));
+
+	EXPECT_EQ(store.size(), 3U);
+	EXPECT_EQ(Opcodes(store), std::vector<ieDword>({ 1, 2, 3 }));
+	EXPECT_EQ(store.front().Opcode, 1U);
+}
+
+TEST(EffectStoreTest, PointersSurviveGrowth)
+{
+	EffectStore store;
+	const Effect* first = &store.push_back(MakeEffect(1000));
+	const Effect* front = &store.push_front(MakeEffect(999));
+	for (ieDword i = 0; i < 500; ++i) {
+		store.push_back(MakeEffect(1001 + i));
+		store.push_front(MakeEffect(998 - i));
+	}
+	EXPECT_EQ(first->Opcode, 1000U);
+	EXPECT_EQ(front->Opcode, 999U);
+
+	ieDword expected = 499;
+	for (const Effect& fx : store) {
+		EXPECT_EQ(fx.Opcode, expected);
+		++expected;
+	}
+	EXPECT_EQ(expected, 1501U);
+}
+
+TEST(EffectStoreTest, CompactionKeepsOrderAndFreesChunks)
+{
+	EffectStore store;
+	for (ieDword i = 0; i < 500; ++i) {
+		store.push_back(MakeEffect(i));
+	}
+	store.push_front(MakeEffect(1000));
+	size_t capacity = store.capacity();
+	EXPECT_GE(capacity, 501U);
+
+	// gaps from erase are closed too
+	store.erase(store.begin());
+	EXPECT_TRUE(store.Compact([](const Effect& fx) { return fx.Opcode % 2 == 1; }));
+
+	EXPECT_EQ(store.size(), 250U);
+	EXPECT_EQ(store.front().Opcode, 0U);
+	ieDword expected = 0;
+	for (const Effect& fx : store) {
+		EXPECT_EQ(fx.Opcode, expected);
+		expected += 2;
+	}
+	EXPECT_LT(store.capacity(), capacity);
+	EXPECT_GE(store.capacity(), 250U);
+
+	// nothing to do the second time around
+	EXPECT_FALSE(store.Compact([](const Effect&) { return false; }));
+
+	store.Compact([](const Effect&) { return true; });
+	EXPECT_TRUE(store.empty());
+	EXPECT_EQ(Opcodes(store), std::vector<ieDword>());
+	EXPECT_LE(store.capacity(), 8U);
+
+	store.push_back(MakeEffect(2));
+	store.push_front(MakeEffect(1));
+	EXPECT_EQ(Opcodes(store), std::vector<ieDword>({ 1, 2 }));
+}
+
+TEST(EffectStoreTest, IteratorsBehaveLikeListIterators)
+{
+	EffectStore store;
+	for (ieDword i = 0; i < 4; ++i) {
+		store.push_back(MakeEffect(i));
+	}
+
+	auto it = store.begin();
+	++it;
+	EXPECT_EQ(it->Opcode, 1U);
+
+	// front insertions don't shift live iterators
+	store.push_front(MakeEffect(10));
+	EXPECT_EQ(it->Opcode, 1U);
+
+	// erasing another entry leaves them alone too
+	auto next = it;
+	++next;
+	store.erase(next);
+	++it;
+	EXPECT_EQ(it->Opcode, 3U);
+
+	// appended entries are still visited, even with a cached end
+	auto end = store.end();
+	store.push_back(MakeEffect(4));
+	++it;
+	ASSERT_NE(it, end);
+	EXPECT_EQ(it->Opcode, 4U);
+	++it;
+	EXPECT_EQ(it, end);
+
+	EXPECT_EQ(Opcodes(store), std::vector<ieDword>({ 10, 0, 1, 3, 4 }));
+}
+
+TEST(EffectStoreTest, CopiesAreIndependent)
+{
+	EffectStore store;
+	store.push_back(MakeEffect(1));
+	store.push_front(MakeEffect(0));
+
+	EffectStore copy = store;
+	copy.push_back(MakeEffect(2));
+	EXPECT_EQ(Opcodes(store), std::vector<ieDword>({ 0, 1 }));
+	EXPECT_EQ(Opcodes(copy), std::vector<ieDword>({ 0, 1, 2 }));
+
+	EffectStore moved = std::move(copy);
+	EXPECT_TRUE(copy.empty());
+	EXPECT_EQ(Opcodes(moved), std::vector<ieDword>({ 0, 1, 2 }));
+}
+
+}
@@ -0,0 +1,139 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/Factory.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+class SizedObject : public FactoryObject {
+public:
+	size_t size;
+
+	SizedObject(const ResRef& name, size_t size)
+		: FactoryObject(name, IE_BAM_CLASS_ID), size(size) {}
+
+	size_t GetMemorySize() const override { return size; }
+};
+
+TEST(Factory_Test, LookupByRefAndType)
+{
+	Factory factory;
+	factory.AddFactoryObject(std::make_shared<SizedObject>("anim", 10));
+
+	EXPECT_NE(factory.GetFactoryObject("anim", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("ANIM", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject("anim", IE_BMP_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject("other", IE_BAM_CLASS_ID), nullptr);
+
+	const auto& stats = factory.GetStats();
+	EXPECT_EQ(stats.hits, 2U);
+	EXPECT_EQ(stats.misses, 2U);
+	EXPECT_EQ(stats.used, 10U);
+	EXPECT_EQ(stats.objects, 1U);
+}
+
+TEST(Factory_Test, EvictsLeastRecentlyUsed)
+{
+	Factory factory { 100 };
+	factory.AddFactoryObject(std::make_shared<SizedObject>("a", 40));
+	factory.AddFactoryObject(std::make_shared<SizedObject>("b", 40));
+	factory.GetFactoryObject("a", IE_BAM_CLASS_ID);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("c", 40));
+
+	EXPECT_NE(factory.GetFactoryObject("a", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject("b", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("c", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().evictions, 1U);
+	EXPECT_EQ(factory.GetStats().used, 80U);
+}
+
+TEST(Factory_Test, KeepsReferencedAndPinned)
+{
+	Factory factory { 100 };
+	auto held = std::make_shared<SizedObject>("held", 40);
+	factory.AddFactoryObject(held);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("pinned", 40), true);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("free", 40));
+
+	// nothing could be dropped yet, so the cache stays over budget
+	factory.AddFactoryObject(std::make_shared<SizedObject>("new", 40));
+	EXPECT_EQ(factory.GetFactoryObject("free", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("held", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("pinned", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().used, 120U);
+
+	held.reset();
+	factory.SetBudget(40);
+	EXPECT_EQ(factory.GetFactoryObject("new", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject("held", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("pinned", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetStats().used, 40U);
+}
+
+// the old linear lookups found the first object added under a name
+TEST(Factory_Test, KeepsFirstObjectOnDuplicateKey)
+{
+	Factory factory;
+	auto first = std::make_shared<SizedObject>("anim", 10);
+	factory.AddFactoryObject(first);
+	factory.AddFactoryObject(std::make_shared<SizedObject>("anim", 20));
+
+	EXPECT_EQ(factory.GetFactoryObject("anim", IE_BAM_CLASS_ID), first);
+	EXPECT_EQ(factory.GetStats().used, 10U);
+	EXPECT_EQ(factory.GetStats().objects, 1U);
+
+	// but a later pin still sticks
+	first.reset();
+	factory.AddFactoryObject(std::make_shared<SizedObject>("anim", 20), true);
+	factory.SetBudget(0);
+	EXPECT_NE(factory.GetFactoryObject("anim", IE_BAM_CLASS_ID), nullptr);
+}
+
+// held objects are set aside once found, then come back when released or looked up
+TEST(Factory_Test, HeldObjectsReturnToTheScan)
+{
+	Factory factory { 100 };
+	std::vector<Factory::object_t> held;
+	for (int i = 0; i < 10; ++i) {
+		std::string name = "held" + std::to_string(i);
+		held.push_back(std::make_shared<SizedObject>(ResRef(name.c_str()), 10));
+		factory.AddFactoryObject(held.back());
+	}
+	for (int i = 0; i < 10; ++i) {
+		std::string name = "free" + std::to_string(i);
+		factory.AddFactoryObject(std::make_shared<SizedObject>(ResRef(name.c_str()), 10));
+	}
+	// only the free ones could go, the most recent one stays as the cache is over budget
+	EXPECT_EQ(factory.GetStats().evictions, 9U);
+	EXPECT_EQ(factory.GetStats().used, 110U);
+	EXPECT_NE(factory.GetFactoryObject("free9", IE_BAM_CLASS_ID), nullptr);
+
+	// looked up again, so the most recently used
+	EXPECT_NE(factory.GetFactoryObject("held0", IE_BAM_CLASS_ID), nullptr);
+	held.clear();
+	factory.SetBudget(20);
+	EXPECT_EQ(factory.GetStats().used, 20U);
+	EXPECT_NE(factory.GetFactoryObject("held0", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_NE(factory.GetFactoryObject("free9", IE_BAM_CLASS_ID), nullptr);
+	EXPECT_EQ(factory.GetFactoryObject("held1", IE_BAM_CLASS_ID), nullptr);
+}
+
+}
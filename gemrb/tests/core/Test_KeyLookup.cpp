@@ -0,0 +1,187 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "Bench.h"
+#include "MapTest.h"
+
+#include "../../core/ResourceSource.h"
+#include "../../core/Streams/FileStream.h"
+
+namespace GemRB {
+
+// a synthetic BIF with fileCount file and tileCount tileset entries, plus the chitin.key listing them all
+static constexpr ieDword fileCount = 10000;
+static constexpr ieDword tileCount = 60;
+static constexpr ieDword payloadSize = 64;
+
+struct BenchEntry {
+	ResRef ref;
+	ieWord type;
+	ieDword locator;
+};
+
+static std::vector<BenchEntry> MakeEntries()
+{
+	std::vector<BenchEntry> entries;
+	for (ieDword i = 0; i < fileCount; ++i) {
+		entries.push_back({ ResRef(fmt::format("bnch{:04}", i).c_str()), IE_BAM_CLASS_ID, i });
+	}
+	for (ieDword i = 0; i < tileCount; ++i) {
+		entries.push_back({ ResRef(fmt::format("bnts{:02}", i).c_str()), IE_TIS_CLASS_ID, (i + 1) << 14 });
+	}
+	return entries;
+}
+
+static bool WriteBIF(const path_t& path, const std::vector<BenchEntry>& entries)
+{
+	FileStream bif;
+	if (!bif.Create(path)) return false;
+
+	bif.Write("BIFFV1  ", 8);
+	bif.WriteDword(fileCount);
+	bif.WriteDword(tileCount);
+	bif.WriteDword(20);
+	// every entry points at the same payload behind the tables
+	ieDword payload = 20 + fileCount * 16 + tileCount * 20;
+	for (const BenchEntry& entry : entries) {
+		bif.WriteDword(entry.locator);
+		bif.WriteDword(payload);
+		if (entry.type == IE_TIS_CLASS_ID) {
+			bif.WriteDword(1);
+		}
+		bif.WriteDword(payloadSize);
+		bif.WriteWord(entry.type);
+		bif.WriteWord(0);
+	}
+	bif.WriteFilling(payloadSize);
+	return true;
+}
+
+static bool WriteKey(const path_t& path, const path_t& bifName, const std::vector<BenchEntry>& entries)
+{
+	FileStream key;
+	if (!key.Create(path)) return false;
+
+	ieDword bifOffset = 24;
+	ieDword nameOffset = bifOffset + 12;
+	ieDword resOffset = nameOffset + ieDword(bifName.length()) + 1;
+	key.Write("KEY V1  ", 8);
+	key.WriteDword(1);
+	key.WriteDword(ieDword(entries.size()));
+	key.WriteDword(bifOffset);
+	key.WriteDword(resOffset);
+	key.WriteDword(0);
+	key.WriteDword(nameOffset);
+	key.WriteWord(ieWord(bifName.length() + 1));
+	key.WriteWord(1);
+	key.Write(bifName.c_str(), bifName.length() + 1);
+	for (const BenchEntry& entry : entries) {
+		key.WriteResRef(entry.ref);
+		key.WriteWord(entry.type);
+		key.WriteDword(entry.locator);
+	}
+	return true;
+}
+
+// loads every resource listed in the key, through the same KEY and BIF importers the game uses
+TEST_F(MapTest, KeyLookupBenchmark)
+{
+	const path_t& dir = core->config.CachePath;
+	const path_t bifName = "benchkey.bif";
+	const path_t keyPath = PathJoin(dir, "benchkey.key");
+	std::vector<BenchEntry> entries = MakeEntries();
+	ASSERT_TRUE(WriteBIF(PathJoin(dir, bifName), entries));
+	ASSERT_TRUE(WriteKey(keyPath, bifName, entries));
+
+	// the BIFs are looked for in the game and CD paths
+	auto& cdPaths = core->config.CD[MAX_CD - 1];
+	cdPaths.push_back(dir);
+	PluginHolder<ResourceSource> key = MakePluginHolder<ResourceSource>(PLUGIN_RESOURCE_KEY);
+	ASSERT_NE(key, nullptr);
+	bool opened = key->Open(keyPath, "bench key");
+	cdPaths.pop_back();
+	ASSERT_TRUE(opened);
+
+	constexpr int runs = 10;
+	std::vector<uint64_t> samples;
+	size_t allocations = AllocationCount();
+	size_t loaded = 0;
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (const BenchEntry& entry : entries) {
+			DataStream* str = key->GetResource(entry.ref, entry.type);
+			loaded += str && str->Size() == payloadSize;
+			delete str;
+		}
+		samples.push_back(ElapsedNs(start));
+	}
+	allocations = AllocationCount() - allocations;
+	EXPECT_EQ(loaded, runs * entries.size());
+	LogBenchmark("KEY+BIF load of every resource", samples, allocations, entries.size());
+
+	// the locator lookup on its own: the old linear search over the BIF entries against the locator index
+	std::vector<ieDword> locators;
+	for (const BenchEntry& entry : entries) {
+		if (entry.type != IE_TIS_CLASS_ID) locators.push_back(entry.locator);
+	}
+	std::vector<const ieDword*> index(fileCount, nullptr);
+	for (const ieDword& locator : locators) {
+		index[locator & 0x3FFF] = &locator;
+	}
+
+	// one run of the quadratic scan is plenty
+	size_t found = 0;
+	samples.clear();
+	for (int run = 0; run < 1; ++run) {
+		auto start = BenchClock::now();
+		for (ieDword wanted : locators) {
+			for (const ieDword& locator : locators) {
+				if ((locator & 0x3FFF) == (wanted & 0x3FFF)) {
+					++found;
+					break;
+				}
+			}
+		}
+		samples.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("BIF lookups, linear search", samples, 0, locators.size());
+
+	samples.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (ieDword wanted : locators) {
+			size_t idx = wanted & 0x3FFF;
+			found += idx < index.size() && index[idx];
+		}
+		samples.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("BIF lookups, locator index", samples, 0, locators.size());
+	EXPECT_EQ(found, (runs + 1) * locators.size());
+
+	key.reset();
+	UnlinkFile(keyPath);
+	UnlinkFile(PathJoin(dir, bifName));
+}
+
+}
+
+#endif
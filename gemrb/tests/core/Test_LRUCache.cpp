@@ -0,0 +1,112 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/LRUCache.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+struct SizedEntry {
+	size_t size = 0;
+	bool busy = false;
+
+	explicit SizedEntry(size_t size, bool busy = false)
+		: size(size), busy(busy) {}
+
+	void evictionNotice() const {}
+};
+
+struct SizedEvictable {
+	bool operator()(const SizedEntry& entry) const { return !entry.busy; }
+};
+
+struct SizedCost {
+	size_t operator()(const SizedEntry& entry) const { return entry.size; }
+};
+
+using SizedCache = LRUCache<SizedEntry, SizedEvictable, SizedCost>;
+using CountedCache = LRUCache<SizedEntry, SizedEvictable>;
+
+TEST(LRUCache_Test, CountsEntriesByDefault)
+{
+	CountedCache cache { 2 };
+	cache.SetAt("a", 100);
+	cache.SetAt("b", 100);
+	cache.SetAt("c", 100);
+
+	EXPECT_EQ(cache.Used(), 2U);
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_NE(cache.Lookup("b"), nullptr);
+	EXPECT_NE(cache.Lookup("c"), nullptr);
+}
+
+TEST(LRUCache_Test, EvictsByCost)
+{
+	SizedCache cache { 100 };
+	cache.SetAt("a", 40);
+	cache.SetAt("b", 40);
+	EXPECT_EQ(cache.Used(), 80U);
+
+	// a is the oldest, but was used last
+	EXPECT_TRUE(cache.Touch("a"));
+	cache.SetAt("c", 30);
+	EXPECT_EQ(cache.Used(), 70U);
+	EXPECT_NE(cache.Lookup("a"), nullptr);
+	EXPECT_EQ(cache.Lookup("b"), nullptr);
+
+	// takes several evictions to make room
+	cache.SetAt("d", 90);
+	EXPECT_EQ(cache.Used(), 90U);
+	EXPECT_NE(cache.Lookup("d"), nullptr);
+
+	EXPECT_TRUE(cache.Remove("d"));
+	EXPECT_EQ(cache.Used(), 0U);
+}
+
+TEST(LRUCache_Test, SkipsBusyEntries)
+{
+	SizedCache cache { 100 };
+	cache.SetAt("busy", 40, true);
+	cache.SetAt("idle", 40);
+	cache.SetAt("new", 40);
+
+	EXPECT_NE(cache.Lookup("busy"), nullptr);
+	EXPECT_EQ(cache.Lookup("idle"), nullptr);
+	EXPECT_EQ(cache.Used(), 80U);
+}
+
+TEST(LRUCache_Test, KeepsOversizedNewest)
+{
+	SizedCache cache { 100 };
+	cache.SetAt("a", 10);
+	cache.SetAt("huge", 500);
+
+	EXPECT_EQ(cache.Lookup("a"), nullptr);
+	EXPECT_NE(cache.Lookup("huge"), nullptr);
+	EXPECT_EQ(cache.Used(), 500U);
+
+	// touching the only entry must keep the queue intact
+	EXPECT_TRUE(cache.Touch("huge"));
+	cache.SetAt("b", 10);
+	EXPECT_EQ(cache.Lookup("huge"), nullptr);
+	EXPECT_EQ(cache.Used(), 10U);
+}
+
+}
@@ -20,52 +20,13 @@
 // FIXME: remove once fixed, this is excluding non-linux build bots
 #if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
 
-#include "../../core/GameData.h"
-#include "../../core/Interface.h"
-#include "../../core/InterfaceConfig.h"
-#include "../../core/Logging/Loggers/Stdio.h"
-#include "../../core/Logging/Logging.h"
-#include "../../core/Map.h"
-#include "../../core/PluginMgr.h"
-#include "../../core/SaveGameMgr.h"
+#include "MapTest.h"
 
-#include <gtest/gtest.h>
+#include "../../includes/ie_stats.h"
 
-namespace GemRB {
-
-class MapTest : public testing::Test {
-public:
-	static const Interface* gemrb;
-	static const Map* map;
-
-	// set up core and the first map from the demo
-	static void SetUpTestSuite()
-	{
-		setlocale(LC_ALL, "");
-		const char* argv[] = { "tester", "-c", "../../tester.cfg" };
-		auto cfg = LoadFromArgs(3, const_cast<char**>(argv));
-		ToggleLogging(true);
-		AddLogWriter(createStdioLogWriter());
-		gemrb = new Interface(std::move(cfg));
-
-		auto gamStream = gamedata->GetResourceStream("gem-demo", IE_GAM_CLASS_ID);
-		auto gamMgr = GetImporter<SaveGameMgr>(IE_GAM_CLASS_ID, gamStream);
-		Game* game = gamMgr->LoadGame(new Game(), 0);
-		core->SetGame(game);
-
-		ResRef mapRef { "ar0100" };
-		map = game->GetMap(mapRef, false);
-	}
+#include "../../core/Scriptable/Actor.h"
 
-	static void TearDownTestSuite()
-	{
-		// cleanup to prevent a delay and crash on exit
-		delete core->GetGame();
-		core->SetGame(nullptr);
-		VideoDriver.reset();
-		delete gemrb;
-	}
-};
+namespace GemRB {
 
 const Map* MapTest::map = nullptr;
 const Interface* MapTest::gemrb = nullptr;
@@ -75,6 +36,15 @@ static Point goodPaths[] = { Point(1126, 601), Point(685, 655), Point(720, 496),
 static SearchmapPoint badPaths2[] = { SearchmapPoint(badPaths[0]), SearchmapPoint(badPaths[1]), SearchmapPoint(badPaths[2]), SearchmapPoint(badPaths[3]) };
 static SearchmapPoint goodPaths2[] = { SearchmapPoint(goodPaths[0]), SearchmapPoint(goodPaths[1]), SearchmapPoint(goodPaths[2]), SearchmapPoint(goodPaths[3]) };
 
+// tester.cfg picks the null video driver, whose blank sprites back the tile props
+TEST_F(MapTest, LoadsWithNullVideo)
+{
+	ASSERT_NE(map, nullptr);
+	EXPECT_FALSE(map->tileProps.GetSize().IsInvalid());
+	EXPECT_NE(map->SmallMap, nullptr);
+	EXPECT_NE(map->tileProps.QuerySearchMap(goodPaths2[0]), PathMapFlags::IMPASSABLE);
+}
+
 TEST_F(MapTest, GetBlockedInLineTest1)
 {
 	// same point
@@ -150,5 +120,115 @@ TEST_F(MapTest, FindPathTest)
 	EXPECT_TRUE(path);
 	EXPECT_GT(path.Size(), 1);
 }
+
+// the search state is reused between calls, so make sure nothing leaks over
+TEST_F(MapTest, FindPathReuseTest)
+{
+	constexpr int circleSize = 2;
+	auto path = map->FindPath(badPaths[0], badPaths[1], circleSize);
+	EXPECT_TRUE(path);
+
+	for (int i = 0; i < 3; i++) {
+		map->FindPath(goodPaths[i], goodPaths[i + 1], circleSize);
+		map->FindPath(badPaths[i + 1], badPaths[i], circleSize);
+	}
+
+	auto path2 = map->FindPath(badPaths[0], badPaths[1], circleSize);
+	EXPECT_EQ(path.Size(), path2.Size());
+	for (size_t i = 0; i < std::min(path.Size(), path2.Size()); i++) {
+		EXPECT_EQ(path.GetStep(i).point, path2.GetStep(i).point);
+	}
+}
+
+// what UpdateFog did before it kept per actor fans: the vision of every exploring
+// actor traced onto a cleared VisibleBitmap
+static void ExpectFogMatchesFullRecompute(Map& area)
+{
+	area.UpdateFog(false);
+	const Bitmap visible = area.VisibleBitmap;
+	const Bitmap explored = area.ExploredBitmap;
+
+	area.VisibleBitmap.fill(0);
+	for (const Actor* actor : area.GetAllActors()) {
+		if (!actor->Modified[IE_EXPLORE]) continue;
+		int range = actor->GetVisualRange() + actor->GetAnims()->GetCircleSize();
+		area.ExploreMapChunk(actor->SMPos, range, 1);
+	}
+
+	const Size fogSize = visible.GetSize();
+	const Bitmap& fullVisible = area.VisibleBitmap;
+	const Bitmap& fullExplored = area.ExploredBitmap;
+	int visibleDiffs = 0;
+	int exploredDiffs = 0;
+	for (int cell = 0; cell < fogSize.Area(); ++cell) {
+		visibleDiffs += visible[cell] != fullVisible[cell];
+		exploredDiffs += explored[cell] != fullExplored[cell];
+	}
+	EXPECT_EQ(visibleDiffs, 0);
+	EXPECT_EQ(exploredDiffs, 0);
+
+	// leave the incremental state as it was
+	area.VisibleBitmap = visible;
+}
+
+// painted like Door::ImpedeBlocks does when a door closes or opens
+static void SetDoor(Map& area, int x, int y1, int y2, bool closed)
+{
+	for (int y = y1; y <= y2; ++y) {
+		SearchmapPoint p(x, y);
+		PathMapFlags tmp = area.tileProps.QuerySearchMap(p) & PathMapFlags::NOTDOOR;
+		area.tileProps.PaintSearchMap(p, closed ? tmp | PathMapFlags::DOOR : tmp);
+	}
+}
+
+// the fog is updated incrementally, so it has to agree with tracing everything again
+TEST_F(MapTest, IncrementalFogMatchesFullRecompute)
+{
+	const Size size(120, 120);
+	std::unique_ptr<Map> area(MakeSyntheticMap(size, 17, 10));
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> xs(0, size.w * 16 - 1);
+	std::uniform_int_distribution<int> ys(0, size.h * 12 - 1);
+
+	for (int i = 0; i < 6; ++i) {
+		Actor* actor = gamedata->GetCreature("rabbit");
+		ASSERT_NE(actor, nullptr);
+		actor->SetBase(IE_EXPLORE, 1);
+		actor->RefreshEffects();
+		actor->SetPos(Point(xs(rng), ys(rng)));
+		area->AddActor(actor, false);
+		actor->Scriptable::SetMap(area.get());
+	}
+	ExpectFogMatchesFullRecompute(*area);
+	ExpectFogMatchesFullRecompute(*area); // nothing changed
+
+	std::vector<Actor*> actors = area->GetAllActors();
+	for (int round = 0; round < 8; ++round) {
+		// a few steps for some, jumps across the map for others
+		for (Actor* actor : actors) {
+			if (rng() % 2) {
+				actor->SetPos(Clamp(actor->Pos + Point(int(rng() % 96) - 48, int(rng() % 72) - 36), Point(), Point(size.w * 16 - 1, size.h * 12 - 1)));
+			} else if (rng() % 3 == 0) {
+				actor->SetPos(Point(xs(rng), ys(rng)));
+			}
+		}
+		ExpectFogMatchesFullRecompute(*area);
+
+		// doors closing in the middle of the map and opening again
+		SetDoor(*area, size.w / 2, 0, size.h - 1, round % 2 == 0);
+		ExpectFogMatchesFullRecompute(*area);
+
+		if (round == 3) {
+			area->FillExplored(false);
+			ExpectFogMatchesFullRecompute(*area);
+		}
+		if (round == 5) {
+			// and one stops exploring
+			actors[0]->Modified[IE_EXPLORE] = 0;
+			ExpectFogMatchesFullRecompute(*area);
+		}
+	}
+}
+
 }
 #endif
@@ -0,0 +1,116 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "Bench.h"
+#include "MapTest.h"
+
+namespace GemRB {
+
+static std::vector<SearchmapPoint> RandomTiles(const Size& size, unsigned int seed, int count)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> xs(0, size.w - 1);
+	std::uniform_int_distribution<int> ys(0, size.h - 1);
+	std::vector<SearchmapPoint> tiles;
+	for (int i = 0; i < count; ++i) {
+		tiles.emplace_back(xs(rng), ys(rng));
+	}
+	return tiles;
+}
+
+// with nothing to block the rays, the row fill has to reveal exactly what the ray walk does
+TEST_F(MapTest, ExploreMapChunkSpansMatchRays)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(200, 200), 1, 0));
+	const std::vector<SearchmapPoint> centers = { SearchmapPoint(100, 100), SearchmapPoint(0, 0), SearchmapPoint(3, 197),
+						      SearchmapPoint(199, 50), SearchmapPoint(-10, 100), SearchmapPoint(100, 215) };
+	for (const SearchmapPoint& center : centers) {
+		for (int range : { -1, 0, 1, 2, 7, 16, 29, 30, 45 }) {
+			area->FillExplored(false);
+			area->VisibleBitmap.fill(0);
+			area->ExploreMapChunk(center, range, 1);
+			Bitmap explored = area->ExploredBitmap;
+			Bitmap visible = area->VisibleBitmap;
+
+			area->FillExplored(false);
+			area->VisibleBitmap.fill(0);
+			area->ExploreMapChunk(center, range, 0);
+			EXPECT_TRUE(std::equal(explored.begin(), explored.end(), area->ExploredBitmap.begin())) << center.x << "," << center.y << " " << range;
+			EXPECT_TRUE(std::equal(visible.begin(), visible.end(), area->VisibleBitmap.begin())) << center.x << "," << center.y << " " << range;
+		}
+	}
+}
+
+TEST_F(MapTest, MapSpansBenchmark)
+{
+	constexpr int maxVisibility = 30;
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(1000, 1000), 18, 15));
+	const Size& size = area->tileProps.GetSize();
+	const std::vector<SearchmapPoint> tiles = RandomTiles(size, 18, 1000);
+
+	std::vector<uint64_t> times;
+	size_t allocations = AllocationCount();
+	for (const SearchmapPoint& tile : tiles) {
+		auto start = BenchClock::now();
+		area->ExploreMapChunk(tile, maxVisibility, 0);
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("ExploreMapChunk rows", times, AllocationCount() - allocations);
+
+	times.clear();
+	allocations = AllocationCount();
+	for (const SearchmapPoint& tile : tiles) {
+		auto start = BenchClock::now();
+		area->ExploreMapChunk(tile, maxVisibility, 1);
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("ExploreMapChunk rays", times, AllocationCount() - allocations);
+
+	// actor circles of all the sizes in the game, painted and cleared like a move does
+	times.clear();
+	allocations = AllocationCount();
+	for (const SearchmapPoint& tile : tiles) {
+		auto start = BenchClock::now();
+		for (uint16_t circle = 1; circle <= 8; ++circle) {
+			area->tileProps.PaintSearchMap(tile, circle, PathMapFlags::NPC);
+			area->tileProps.PaintSearchMap(tile, circle, PathMapFlags::UNMARKED);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("PaintSearchMap circles", times, AllocationCount() - allocations, 16);
+
+	times.clear();
+	allocations = AllocationCount();
+	int open = 0;
+	for (const SearchmapPoint& tile : tiles) {
+		auto start = BenchClock::now();
+		for (uint16_t circle = 1; circle <= 8; ++circle) {
+			open += bool(area->tileProps.QueryBlockedInRadius(tile, circle - 1, false) & PathMapFlags::PASSABLE);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("QueryBlockedInRadius", times, AllocationCount() - allocations, 8);
+	EXPECT_GT(open, 0);
+}
+
+}
+#endif
@@ -0,0 +1,152 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "Bench.h"
+#include "MapTest.h"
+
+namespace GemRB {
+
+static Point RandomPassable(const Map& area, std::mt19937& rng, const SearchmapPoint& near, int range)
+{
+	const Size& size = area.tileProps.GetSize();
+	std::uniform_int_distribution<int> offset(-range, range);
+	while (true) {
+		SearchmapPoint p(Clamp(near.x + offset(rng), 0, size.w - 1), Clamp(near.y + offset(rng), 0, size.h - 1));
+		if (area.tileProps.QuerySearchMap(p) == PathMapFlags::PASSABLE) {
+			return Point(p.x * 16 + 8, p.y * 12 + 6);
+		}
+	}
+}
+
+static unsigned int PathLength(const Point& from, const Path& path)
+{
+	unsigned int length = 0;
+	Point previous = from;
+	for (const PathNode& node : path.nodes) {
+		length += Distance(previous, node.point);
+		previous = node.point;
+	}
+	return length;
+}
+
+// the hierarchical search has to reach the same places as the flat one, over walkable legs of a comparable length
+TEST_F(MapTest, HierarchicalFindPathMatchesFlat)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(300, 300), 300, 15));
+	PathClusters& clusters = area->tileProps.pathClusters;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> coord(0, 299);
+
+	constexpr int circleSize = 2;
+	for (int i = 0; i < 100; ++i) {
+		Point from = RandomPassable(*area, rng, SearchmapPoint(coord(rng), coord(rng)), 10);
+		Point to = RandomPassable(*area, rng, SearchmapPoint(from), i % 2 ? 150 : 20);
+		SCOPED_TRACE(fmt::format("{} -> {}", from, to));
+
+		clusters.enabled = false;
+		Path flat = area->FindPath(from, to, circleSize);
+		clusters.enabled = true;
+		Path hierarchical = area->FindPath(from, to, circleSize);
+
+		ASSERT_EQ(bool(flat), bool(hierarchical));
+		if (!flat) continue;
+		EXPECT_EQ(SearchmapPoint(flat.nodes.back().point), SearchmapPoint(hierarchical.nodes.back().point));
+		Point previous = from;
+		for (const PathNode& node : hierarchical.nodes) {
+			EXPECT_TRUE(area->IsWalkableTo(previous, node.point, false, nullptr));
+			previous = node.point;
+		}
+		EXPECT_LE(PathLength(from, hierarchical), PathLength(from, flat) * 3 / 2 + 40);
+	}
+}
+
+// closing and reopening the only gap in a wall, like a door, has to reach the cached entrances
+TEST_F(MapTest, HierarchicalFindPathFollowsSearchmapChanges)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(64, 64), 64, 0));
+	area->tileProps.pathClusters.enabled = true;
+	constexpr uint8_t passable = uint8_t(PathMapFlags::PASSABLE);
+	constexpr uint8_t impassable = uint8_t(PathMapFlags::IMPASSABLE);
+	for (int y = 0; y < 64; ++y) {
+		area->tileProps.SetTileProp(SearchmapPoint(32, y), TileProps::Property::SEARCH_MAP, y == 40 ? passable : impassable);
+	}
+
+	Point from(10 * 16 + 8, 10 * 12 + 6);
+	Point to(50 * 16 + 8, 10 * 12 + 6);
+	Path path = area->FindPath(from, to, 2);
+	ASSERT_TRUE(path);
+	EXPECT_EQ(SearchmapPoint(path.nodes.back().point), SearchmapPoint(to));
+
+	area->tileProps.SetTileProp(SearchmapPoint(32, 40), TileProps::Property::SEARCH_MAP, impassable);
+	EXPECT_FALSE(area->FindPath(from, to, 2));
+
+	area->tileProps.SetTileProp(SearchmapPoint(32, 20), TileProps::Property::SEARCH_MAP, passable);
+	path = area->FindPath(from, to, 2);
+	ASSERT_TRUE(path);
+	EXPECT_EQ(SearchmapPoint(path.nodes.back().point), SearchmapPoint(to));
+}
+
+// reproducible FindPath queries on a synthetic 1000x1000 searchmap, half of them short walks,
+// the rest across up to 200 tiles, like actors chasing targets and crossing the area
+TEST_F(MapTest, FindPathBenchmark)
+{
+	std::unique_ptr<Map> area(MakeSyntheticMap(Size(1000, 1000), 1000, 15));
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> coord(0, 999);
+
+	constexpr int queries = 100;
+	std::vector<std::pair<Point, Point>> endpoints;
+	for (int i = 0; i < queries; ++i) {
+		SearchmapPoint start(coord(rng), coord(rng));
+		Point from = RandomPassable(*area, rng, start, 10);
+		Point to = RandomPassable(*area, rng, SearchmapPoint(from), i % 2 ? 200 : 20);
+		endpoints.emplace_back(from, to);
+	}
+
+	constexpr int circleSize = 2;
+	int found = 0;
+	for (bool hierarchical : { false, true }) {
+		area->tileProps.pathClusters.enabled = hierarchical;
+		// a first pass sizes the scratch buffers and builds the clusters
+		for (const auto& query : endpoints) {
+			area->FindPath(query.first, query.second, circleSize);
+		}
+
+		std::vector<uint64_t> times;
+		found = 0;
+		size_t allocations = AllocationCount();
+		for (const auto& query : endpoints) {
+			auto start = BenchClock::now();
+			Path path = area->FindPath(query.first, query.second, circleSize);
+			times.push_back(ElapsedNs(start));
+			found += bool(path);
+		}
+		allocations = AllocationCount() - allocations;
+
+		LogBenchmark(hierarchical ? "FindPath (hierarchical)" : "FindPath", std::move(times), allocations);
+	}
+	RecordProperty("found", found);
+	EXPECT_GT(found, queries / 2);
+}
+
+}
+#endif
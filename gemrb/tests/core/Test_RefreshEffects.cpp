@@ -0,0 +1,184 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2025 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// FIXME: remove once fixed, this is excluding non-linux build bots
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+#include "Bench.h"
+#include "MapTest.h"
+
+#include "../../includes/ie_stats.h"
+
+#include "../../core/Scriptable/Actor.h"
+
+namespace GemRB {
+
+// plain modifiers, with strength and dexterity making every refresh reapply the whole queue;
+// set by their usual opcode numbers, which the test effects.ids binds to the handlers
+static EffectRef benchEffects[] = {
+	{ "StrengthModifier", 0x2c },
+	{ "DexterityModifier", 0xf },
+	{ "LuckModifier", 0x16 },
+	{ "FireResistanceModifier", 0x1e },
+	{ "ColdResistanceModifier", 0x1c },
+	{ "LoreModifier", 0x15 }
+};
+
+// the demo rabbit, loaded for its set up inventory and stats, with effectCount modifiers on top
+static Actor* MakeSyntheticActor(int effectCount)
+{
+	Actor* actor = gamedata->GetCreature("rabbit");
+	if (!actor) {
+		return nullptr;
+	}
+	for (int i = 0; i < effectCount; ++i) {
+		EffectRef& ref = benchEffects[i % (sizeof(benchEffects) / sizeof(benchEffects[0]))];
+		Effect* fx = EffectQueue::CreateEffect(ref, 1, 0, FX_DURATION_INSTANT_WHILE_EQUIPPED);
+		if (!fx) {
+			delete actor;
+			return nullptr;
+		}
+		actor->fxqueue.AddEffect(fx);
+	}
+	actor->RefreshEffects();
+	return actor;
+}
+
+TEST_F(MapTest, RefreshEffectsBenchmark)
+{
+	for (int effectCount : { 50, 200, 1000 }) {
+		std::unique_ptr<Actor> actor(MakeSyntheticActor(effectCount));
+		ASSERT_NE(actor, nullptr);
+		ASSERT_GE(actor->fxqueue.GetEffectsCount(), size_t(effectCount));
+		EXPECT_GT(actor->GetStat(IE_RESISTFIRE), actor->GetBase(IE_RESISTFIRE));
+
+		constexpr int runs = 200;
+		std::vector<uint64_t> samples;
+		samples.reserve(runs);
+		size_t allocations = AllocationCount();
+		for (int run = 0; run < runs; ++run) {
+			auto start = BenchClock::now();
+			actor->RefreshEffects();
+			samples.push_back(ElapsedNs(start));
+		}
+		allocations = AllocationCount() - allocations;
+
+		std::string name = fmt::format("RefreshEffects, {} effects", effectCount);
+		LogBenchmark(name.c_str(), samples, allocations, effectCount);
+	}
+}
+
+// modifiers of a single stat each, so refreshes only reapply those of stats with changed inputs
+static EffectRef statEffects[] = {
+	{ "LuckModifier", 0x16 },
+	{ "FireResistanceModifier", 0x1e },
+	{ "ColdResistanceModifier", 0x1c },
+	{ "LoreModifier", 0x15 }
+};
+
+static Effect* NextEffect(Actor& actor, ieDword opcode)
+{
+	auto f = actor.fxqueue.GetFirstEffect();
+	for (Effect* fx = actor.fxqueue.GetNextEffect(f); fx; fx = actor.fxqueue.GetNextEffect(f)) {
+		if (fx->Opcode == opcode && fx->TimingMode != FX_DURATION_JUST_EXPIRED) return fx;
+	}
+	return nullptr;
+}
+
+// refreshes the actor and compares it to a fresh copy, which has no earlier results to reuse
+static void ExpectMatchesFullRecompute(Actor& actor)
+{
+	actor.RefreshEffects();
+
+	std::unique_ptr<Actor> fresh(gamedata->GetCreature("rabbit"));
+	ASSERT_NE(fresh, nullptr);
+	fresh->BaseStats = actor.BaseStats;
+	fresh->fxqueue = actor.fxqueue;
+	fresh->fxqueue.SetOwner(fresh.get());
+	fresh->RefreshEffects();
+
+	for (unsigned int i = 0; i < MAX_STATS; ++i) {
+		EXPECT_EQ(actor.Modified[i], fresh->Modified[i]) << "stat " << i;
+	}
+}
+
+TEST_F(MapTest, IncrementalRefreshMatchesFullRecompute)
+{
+	std::unique_ptr<Actor> actor(gamedata->GetCreature("rabbit"));
+	ASSERT_NE(actor, nullptr);
+	for (int i = 0; i < 12; ++i) {
+		EffectRef& ref = statEffects[i % (sizeof(statEffects) / sizeof(statEffects[0]))];
+		Effect* fx = EffectQueue::CreateEffect(ref, i + 1, i % 2 ? MOD_ADDITIVE : MOD_ABSOLUTE, FX_DURATION_INSTANT_WHILE_EQUIPPED);
+		ASSERT_NE(fx, nullptr);
+		actor->fxqueue.AddEffect(fx);
+	}
+	ExpectMatchesFullRecompute(*actor);
+	ExpectMatchesFullRecompute(*actor); // nothing changed
+
+	// changed parameters of one stat's effect
+	Effect* fire = NextEffect(*actor, 0x1e);
+	ASSERT_NE(fire, nullptr);
+	int fireBefore = actor->Modified[IE_RESISTFIRE];
+	fire->Parameter1 += 40;
+	fire->Parameter2 = MOD_ADDITIVE;
+	ExpectMatchesFullRecompute(*actor);
+	EXPECT_NE(actor->Modified[IE_RESISTFIRE], fireBefore);
+
+	// fields the result doesn't depend on for these opcodes, but which are part of the key
+	Effect* cold = NextEffect(*actor, 0x1c);
+	ASSERT_NE(cold, nullptr);
+	cold->Parameter3 = 7;
+	cold->Resource = "SPWI101";
+	cold->IsVariable = 2;
+	ExpectMatchesFullRecompute(*actor);
+
+	// a lore change turned into guaranteed identification
+	Effect* lore = NextEffect(*actor, 0x15);
+	ASSERT_NE(lore, nullptr);
+	lore->Parameter2 = 2;
+	ExpectMatchesFullRecompute(*actor);
+	EXPECT_EQ(actor->Modified[IE_LORE], 100);
+
+	// added and removed effects
+	Effect* luck = EffectQueue::CreateEffect(statEffects[0], 3, MOD_ADDITIVE, FX_DURATION_INSTANT_WHILE_EQUIPPED);
+	ASSERT_NE(luck, nullptr);
+	actor->fxqueue.AddEffect(luck, true);
+	ExpectMatchesFullRecompute(*actor);
+	NextEffect(*actor, 0x1e)->TimingMode = FX_DURATION_JUST_EXPIRED;
+	actor->fxqueue.Cleanup();
+	ExpectMatchesFullRecompute(*actor);
+	actor->fxqueue.RemoveAllEffects(0x1c);
+	ExpectMatchesFullRecompute(*actor);
+
+	// changed inputs of a stat without changing its effects
+	actor->SetBase(IE_LUCK, actor->GetBase(IE_LUCK) + 2);
+	ExpectMatchesFullRecompute(*actor);
+
+	// and back to a full recompute once something else joins the queue
+	Effect* str = EffectQueue::CreateEffect(benchEffects[0], 1, MOD_ADDITIVE, FX_DURATION_INSTANT_WHILE_EQUIPPED);
+	ASSERT_NE(str, nullptr);
+	actor->fxqueue.AddEffect(str);
+	ExpectMatchesFullRecompute(*actor);
+	actor->fxqueue.RemoveAllEffects(0x2c);
+	ExpectMatchesFullRecompute(*actor);
+}
+
+}
+
+#endif
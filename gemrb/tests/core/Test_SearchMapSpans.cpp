@@ -0,0 +1,205 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "Bench.h"
+
+#include "../../core/Bitmap.h"
+#include "../../core/SearchMapSpans.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace GemRB {
+
+static constexpr uint32_t SHIFT = 24;
+
+// every searchmap value in the high byte, with some noise in the other properties
+static std::vector<uint32_t> AllValues()
+{
+	std::vector<uint32_t> pixels;
+	for (uint32_t value = 0; value < 256; ++value) {
+		pixels.push_back((value << SHIFT) | (value * 0x010203));
+	}
+	return pixels;
+}
+
+// the one tile at a time versions the kernels replaced
+static PathMapFlags ReferenceBlocked(PathMapFlags ret)
+{
+	if (bool(ret & PathMapFlags::TRAVEL)) {
+		ret |= PathMapFlags::PASSABLE;
+	}
+	if (bool(ret & (PathMapFlags::DOOR_IMPASSABLE | PathMapFlags::ACTOR))) {
+		ret &= ~PathMapFlags::PASSABLE;
+	}
+	if (bool(ret & PathMapFlags::DOOR_OPAQUE)) {
+		ret = PathMapFlags::SIDEWALL;
+	}
+	return ret;
+}
+
+static uint32_t ReferencePaint(uint32_t pixel, PathMapFlags value)
+{
+	PathMapFlags mapval = PathMapFlags((pixel >> SHIFT) & 0xff);
+	if (mapval == PathMapFlags::IMPASSABLE) {
+		return pixel;
+	}
+	PathMapFlags newVal = (mapval & PathMapFlags::NOTACTOR) | value;
+	return (pixel & 0x00ffffff) | (uint32_t(newVal) << SHIFT);
+}
+
+TEST(SearchMapSpans_Test, ResolvesLikeGetBlockedTile)
+{
+	for (uint32_t value = 0; value < 256; ++value) {
+		EXPECT_EQ(ResolveBlockedFlags(PathMapFlags(value)), ReferenceBlocked(PathMapFlags(value))) << value;
+	}
+}
+
+TEST(SearchMapSpans_Test, PaintsOnlyPassableTiles)
+{
+	for (PathMapFlags value : { PathMapFlags::UNMARKED, PathMapFlags::PC, PathMapFlags::NPC }) {
+		std::vector<uint32_t> pixels = AllValues();
+		std::vector<uint32_t> expected = pixels;
+		for (uint32_t& pixel : expected) {
+			pixel = ReferencePaint(pixel, value);
+		}
+
+		PaintSearchMapSpan(pixels.data(), int(pixels.size()), value, SHIFT);
+		EXPECT_EQ(pixels, expected);
+	}
+}
+
+TEST(SearchMapSpans_Test, CollectsBlockedFlags)
+{
+	std::vector<uint32_t> pixels = AllValues();
+	PathMapFlags flags = PathMapFlags::IMPASSABLE;
+	// the first value is impassable
+	EXPECT_FALSE(BlockedSearchMapSpan(pixels.data(), int(pixels.size()), SHIFT, flags));
+
+	PathMapFlags expected = PathMapFlags::IMPASSABLE;
+	for (uint32_t pixel : pixels) {
+		expected |= ReferenceBlocked(PathMapFlags(pixel >> SHIFT));
+	}
+	EXPECT_EQ(flags, expected);
+
+	flags = PathMapFlags::IMPASSABLE;
+	uint32_t open[] = { uint32_t(PathMapFlags::PASSABLE) << SHIFT, uint32_t(PathMapFlags::TRAVEL) << SHIFT };
+	EXPECT_TRUE(BlockedSearchMapSpan(open, 2, SHIFT, flags));
+	EXPECT_EQ(flags, PathMapFlags::PASSABLE | PathMapFlags::TRAVEL);
+}
+
+TEST(SearchMapSpans_Test, FillsBitmapSpans)
+{
+	// every start and length around the byte boundaries of a few bytes
+	for (int start = 0; start < 24; ++start) {
+		for (int count = 0; start + count <= 40; ++count) {
+			for (bool set : { true, false }) {
+				Bitmap bits(Size(40, 1), set ? 0x00 : 0xff);
+				bits.FillSpan(start, count, set);
+				for (int i = 0; i < 40; ++i) {
+					bool inside = i >= start && i < start + count;
+					EXPECT_EQ(static_cast<const Bitmap&>(bits)[i], inside ? set : !set) << start << " " << count << " " << i;
+				}
+			}
+		}
+	}
+}
+
+// the kernels against the one tile at a time versions over a 1000x1000 map worth of pixels
+TEST(SearchMapSpans_Test, Benchmark)
+{
+	constexpr int rows = 1000;
+	constexpr int width = 1000;
+	std::vector<uint32_t> pixels;
+	while (pixels.size() < size_t(rows * width)) {
+		std::vector<uint32_t> values = AllValues();
+		pixels.insert(pixels.end(), values.begin(), values.end());
+	}
+	pixels.resize(rows * width);
+	constexpr int runs = 10;
+
+	std::vector<uint64_t> times;
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (int row = 0; row < rows; ++row) {
+			PaintSearchMapSpan(&pixels[row * width], width, run % 2 ? PathMapFlags::PC : PathMapFlags::UNMARKED, SHIFT);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("PaintSearchMapSpan", times, 0, rows * width);
+
+	times.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (uint32_t& pixel : pixels) {
+			pixel = ReferencePaint(pixel, run % 2 ? PathMapFlags::PC : PathMapFlags::UNMARKED);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("PaintSearchMap per tile", times, 0, rows * width);
+
+	PathMapFlags spanFlags = PathMapFlags::IMPASSABLE;
+	times.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (int row = 0; row < rows; ++row) {
+			BlockedSearchMapSpan(&pixels[row * width], width, SHIFT, spanFlags);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("BlockedSearchMapSpan", times, 0, rows * width);
+
+	PathMapFlags tileFlags = PathMapFlags::IMPASSABLE;
+	times.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (uint32_t pixel : pixels) {
+			tileFlags |= ReferenceBlocked(PathMapFlags(pixel >> SHIFT));
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("BlockedSearchMap per tile", times, 0, rows * width);
+	EXPECT_EQ(spanFlags, tileFlags);
+
+	Bitmap bits(Size(width, rows), uint8_t(0));
+	times.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (int row = 0; row < rows; ++row) {
+			bits.FillSpan(row * width + row % 8, width - 16, run % 2);
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("Bitmap::FillSpan", times, 0, rows * (width - 16));
+
+	times.clear();
+	for (int run = 0; run < runs; ++run) {
+		auto start = BenchClock::now();
+		for (int row = 0; row < rows; ++row) {
+			for (int i = row * width + row % 8; i < row * width + row % 8 + width - 16; ++i) {
+				bits[i] = run % 2;
+			}
+		}
+		times.push_back(ElapsedNs(start));
+	}
+	LogBenchmark("Bitmap per bit", times, 0, rows * (width - 16));
+}
+
+}
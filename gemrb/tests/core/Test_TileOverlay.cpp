@@ -0,0 +1,188 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/TileOverlay.h"
+
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+#include "MapTest.h"
+
+#include "../../core/Game.h"
+#endif
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static Holder<Sprite2D> MakeTileSprite()
+{
+	return MakeHolder<Sprite2D>(Region(0, 0, 64, 64), nullptr, PixelFormat());
+}
+
+TEST(TileSpriteCache_Test, LookupAfterAdd)
+{
+	TileSpriteCache cache { 4 };
+	auto sprite = MakeTileSprite();
+	cache.Add(7, sprite);
+
+	EXPECT_EQ(cache.Lookup(7), sprite);
+	EXPECT_EQ(cache.Lookup(8), nullptr);
+	EXPECT_EQ(cache.Size(), 1U);
+}
+
+TEST(TileSpriteCache_Test, DropsLeastRecentlyUsed)
+{
+	TileSpriteCache cache { 2 };
+	cache.Add(1, MakeTileSprite());
+	cache.Add(2, MakeTileSprite());
+	cache.Lookup(1);
+	cache.Add(3, MakeTileSprite());
+
+	EXPECT_NE(cache.Lookup(1), nullptr);
+	EXPECT_EQ(cache.Lookup(2), nullptr);
+	EXPECT_NE(cache.Lookup(3), nullptr);
+	EXPECT_EQ(cache.Size(), 2U);
+}
+
+TEST(TileSpriteCache_Test, ShrinksWithCapacity)
+{
+	TileSpriteCache cache { 4 };
+	for (ieWord i = 0; i < 4; ++i) {
+		cache.Add(i, MakeTileSprite());
+	}
+
+	cache.SetCapacity(1);
+	EXPECT_EQ(cache.Size(), 1U);
+	EXPECT_NE(cache.Lookup(3), nullptr);
+}
+
+TEST(Tile_Test, FrameIndicesFollowDoorState)
+{
+	Animation closed(std::vector<Animation::frame_t>(2), 15);
+	Animation open(std::vector<Animation::frame_t>(1), 15);
+	Tile tile(std::move(closed), { 4, 5 }, std::move(open), { 9 });
+
+	EXPECT_EQ(tile.GetAnimationIndex(), 0);
+	EXPECT_EQ(tile.GetFrameIndices(0).size(), 2U);
+	tile.tileIndex = 1;
+	EXPECT_EQ(tile.GetAnimationIndex(), 1);
+	EXPECT_EQ(tile.GetFrameIndices(1)[0], 9);
+}
+
+static Animation MakeTileAnimation(size_t frames)
+{
+	std::vector<Animation::frame_t> sprites;
+	for (size_t i = 0; i < frames; ++i) {
+		sprites.push_back(MakeTileSprite());
+	}
+	return Animation(std::move(sprites), 15);
+}
+
+TEST(TileOverlay_Test, OnlyPlainTilesAreStatic)
+{
+	Tile plain(MakeTileAnimation(1));
+	EXPECT_TRUE(TileOverlay::IsStaticTile(plain));
+
+	Tile door(MakeTileAnimation(1), MakeTileAnimation(1));
+	EXPECT_FALSE(TileOverlay::IsStaticTile(door));
+
+	Tile water(MakeTileAnimation(1));
+	water.om = 1;
+	EXPECT_FALSE(TileOverlay::IsStaticTile(water));
+
+	Tile animated(MakeTileAnimation(2));
+	EXPECT_FALSE(TileOverlay::IsStaticTile(animated));
+}
+
+#if defined(USE_OPENGL_BACKEND) || (!defined(__APPLE__) && !defined(WIN32))
+
+static TileOverlay MakeStaticOverlay(const Size& size)
+{
+	TileOverlay overlay(size);
+	for (int i = 0; i < size.Area(); ++i) {
+		overlay.AddTile(Tile(MakeTileAnimation(1)));
+	}
+	return overlay;
+}
+
+TEST_F(MapTest, ChunksRecompositeOnFlagsAndTint)
+{
+	TileOverlay overlay = MakeStaticOverlay(Size(16, 16));
+	std::vector<TileOverlay::TileOverlayPtr> overlays;
+	const Region viewport(0, 0, 640, 480);
+	// 3x2 chunks of 4x4 tiles cover the viewport
+	const size_t visibleChunks = 6;
+
+	overlay.Draw(viewport, overlays, BlitFlags::NONE);
+	EXPECT_EQ(overlay.GetStats().composited, visibleChunks);
+	overlay.Draw(viewport, overlays, BlitFlags::NONE);
+	EXPECT_EQ(overlay.GetStats().composited, visibleChunks);
+
+	overlay.Draw(viewport, overlays, BlitFlags::HALFTRANS);
+	EXPECT_EQ(overlay.GetStats().composited, 2 * visibleChunks);
+
+	// the global tint comes from the current area, going from dream to night keeps the flags
+	Game* game = core->GetGame();
+	Map* area = game->GetMap(0);
+	ieDword areaFlags = area->AreaFlags;
+	MapEnv areaType = area->AreaType;
+	ieDword gameTime = game->GameTime;
+	game->SetMap(area);
+	area->AreaFlags |= AF_DREAM;
+	overlay.Draw(viewport, overlays, BlitFlags::HALFTRANS);
+	EXPECT_EQ(overlay.GetStats().composited, 3 * visibleChunks);
+	overlay.Draw(viewport, overlays, BlitFlags::HALFTRANS);
+	EXPECT_EQ(overlay.GetStats().composited, 3 * visibleChunks);
+
+	area->AreaFlags = areaFlags & ~AF_DREAM;
+	area->AreaType = MapEnv(AT_OUTDOOR | AT_DAYNIGHT);
+	game->GameTime = 0;
+	overlay.Draw(viewport, overlays, BlitFlags::HALFTRANS);
+	EXPECT_EQ(overlay.GetStats().composited, 4 * visibleChunks);
+
+	area->AreaFlags = areaFlags;
+	area->AreaType = areaType;
+	game->GameTime = gameTime;
+	game->SetMap(nullptr);
+
+	EXPECT_EQ(overlay.GetStats().buffersCreated, visibleChunks);
+}
+
+TEST_F(MapTest, EvictedChunkBuffersAreReused)
+{
+	TileOverlay overlay = MakeStaticOverlay(Size(40, 40));
+	std::vector<TileOverlay::TileOverlayPtr> overlays;
+
+	// sweep the 10x10 chunks row by row
+	for (int y = 0; y + 480 <= 40 * 64; y += 256) {
+		for (int x = 0; x + 640 <= 40 * 64; x += 256) {
+			overlay.Draw(Region(x, y, 640, 480), overlays, BlitFlags::NONE);
+		}
+	}
+
+	const TileOverlay::Stats& stats = overlay.GetStats();
+	EXPECT_GT(stats.buffersReused, 0U);
+	EXPECT_EQ(stats.buffersCreated + stats.buffersReused, stats.composited);
+	// at most the kept chunks, one screen of new ones and the spares are ever alive
+	EXPECT_LE(stats.buffersCreated, 20U + 6U + 8U);
+	EXPECT_LT(stats.buffersCreated, stats.composited);
+}
+
+#endif
+
+}
@@ -0,0 +1,84 @@
+/* GemRB - Infinity Engine Emulator
+* Copyright (C) 2025 The GemRB Project
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*
+*/
+
+#include "../../core/WallGrid.h"
+
+#include <gtest/gtest.h>
+
+namespace GemRB {
+
+static std::shared_ptr<WallPolygon> MakeWall(const Region& rect)
+{
+	std::vector<Point> points { rect.origin, Point(rect.x + rect.w, rect.y), rect.Maximum(), Point(rect.x, rect.y + rect.h) };
+	return std::make_shared<WallPolygon>(std::move(points), &rect);
+}
+
+TEST(WallGrid_Test, FindsOverlappingWallsOnce)
+{
+	auto small = MakeWall(Region(10, 10, 20, 20));
+	auto wide = MakeWall(Region(0, 300, 1000, 40)); // spans several cells and groups
+	auto far = MakeWall(Region(900, 900, 30, 30));
+	// the wall groups list polygons once per group they touch
+	WallGrid grid({ { small, wide }, { wide, far } });
+
+	WallPolygonSet set;
+	grid.Query(Region(0, 0, 1000, 1000), set, false, nullptr);
+	EXPECT_EQ(set.first, WallPolygonGroup({ small, wide, far }));
+	EXPECT_TRUE(set.second.empty());
+
+	grid.Query(Region(500, 250, 100, 100), set, false, nullptr);
+	EXPECT_EQ(set.first, WallPolygonGroup({ wide }));
+
+	grid.Query(Region(2000, 2000, 10, 10), set, false, nullptr);
+	EXPECT_TRUE(set.first.empty());
+}
+
+TEST(WallGrid_Test, SkipsDisabledWalls)
+{
+	auto wall = MakeWall(Region(100, 100, 50, 50));
+	WallGrid grid({ { wall } });
+
+	WallPolygonSet set;
+	wall->SetDisabled(true);
+	grid.Query(Region(0, 0, 200, 200), set, false, nullptr);
+	EXPECT_TRUE(set.first.empty());
+
+	grid.Query(Region(0, 0, 200, 200), set, true, nullptr);
+	EXPECT_EQ(set.first.size(), 1U);
+}
+
+TEST(WallGrid_Test, SplitsByLocation)
+{
+	auto wall = MakeWall(Region(100, 100, 100, 50));
+	wall->SetBaseline(Point(100, 150), Point(200, 150));
+	wall->SetPolygonFlag(WF_BASELINE);
+	WallGrid grid({ { wall } });
+
+	WallPolygonSet set;
+	Point above(150, 120);
+	Point below(150, 180);
+	grid.Query(Region(0, 0, 300, 300), set, false, &below);
+	bool behindFromBelow = !set.first.empty();
+	grid.Query(Region(0, 0, 300, 300), set, false, &above);
+	bool behindFromAbove = !set.first.empty();
+	EXPECT_NE(behindFromAbove, behindFromBelow);
+	EXPECT_EQ(set.first.size() + set.second.size(), 1U);
+}
+
+}
@@ -77,6 +77,18 @@ strret_t WindowsFile::Read(void* ptr, size_t length)
 	return bytesRead;
 }
 
+strret_t WindowsFile::ReadAt(void* ptr, size_t length, strpos_t offset)
+{
+	// the offset in OVERLAPPED is used even for synchronous handles
+	OVERLAPPED overlapped {};
+	overlapped.Offset = static_cast<DWORD>(offset);
+	overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+
+	DWORD bytesRead = 0;
+	ReadFile(file, ptr, length, &bytesRead, &overlapped);
+	return bytesRead;
+}
+
 strret_t WindowsFile::Write(const void* ptr, strpos_t length)
 {
 	DWORD bytesWritten = 0;
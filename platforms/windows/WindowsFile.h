@@ -42,6 +42,7 @@ public:
 	bool OpenRW(const path_t& name) override;
 	bool OpenNew(const path_t& name) override;
 	strret_t Read(void* ptr, size_t length) override;
+	strret_t ReadAt(void* ptr, size_t length, strpos_t offset) override;
 	strret_t Write(const void* ptr, strpos_t length) override;
 	bool SeekStart(stroff_t offset) override;
 	bool SeekCurrent(stroff_t offset) override;